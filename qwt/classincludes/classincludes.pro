@@ -90,6 +90,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtLegend \
         QwtLegendData \
         QwtLegendLabel \
+        QwtVirtualLegend \
         QwtPointMapper \
         QwtMatrixRasterData \
         QwtOHLCSample \
@@ -100,10 +101,12 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotCurve \
         QwtPlotDict \
         QwtPlotDirectPainter \
+        QwtPlotFrameRecord \
         QwtPlotGrid \
         QwtPlotHistogram \
         QwtPlotIntervalCurve \
         QwtPlotItem \
+        QwtPlotItemRecord \
         QwtPlotLayout \
         QwtPlotLegendItem \
         QwtPlotMagnifier \
@@ -113,6 +116,7 @@ contains(QWT_CONFIG, QwtPlot) {
         QwtPlotPicker \
         QwtPlotRasterItem \
         QwtPlotRenderer \
+        QwtPlotImageRenderer \
         QwtPlotRescaler \
         QwtPlotScaleItem \
         QwtPlotSeriesItem \
@@ -0,0 +1,230 @@
+#include "benchmark.h"
+#include <qwt_plot.h>
+#include <qwt_plot_item.h>
+#include <qwt_plot_renderer.h>
+#include <qwt_graphic.h>
+#include <qwt_system_clock.h>
+#include <qimage.h>
+#include <qpainter.h>
+#include <qbuffer.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <stdio.h>
+
+#ifndef QWT_NO_SVG
+#include <qsvggenerator.h>
+#endif
+
+#ifndef QT_NO_PRINTER
+#include <qprinter.h>
+#endif
+
+static void resetStatistics( const QwtPlot *plot )
+{
+    const QwtPlotItemList &items = plot->itemList();
+    for ( int i = 0; i < items.size(); i++ )
+        items[i]->resetPaintStatistics();
+}
+
+static void getStatistics( const QwtPlot *plot,
+    size_t &numSamples, size_t &numPoints )
+{
+    numSamples = numPoints = 0;
+
+    const QwtPlotItemList &items = plot->itemList();
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        size_t samples, points;
+        items[i]->getPaintStatistics( samples, points );
+
+        numSamples += samples;
+        numPoints += points;
+    }
+}
+
+Benchmark::Benchmark():
+    d_format( Csv ),
+    d_numFrames( 20 ),
+    d_out( stdout )
+{
+    d_sizes += QSize( 800, 600 );
+}
+
+void Benchmark::setFormat( Format format )
+{
+    d_format = format;
+}
+
+void Benchmark::setNumFrames( int numFrames )
+{
+    d_numFrames = qMax( numFrames, 1 );
+}
+
+void Benchmark::setSizes( const QList<QSize> &sizes )
+{
+    d_sizes = sizes;
+}
+
+void Benchmark::setFilter( const QString &filter )
+{
+    d_filter = filter;
+}
+
+bool Benchmark::accepts( const QString &name ) const
+{
+    return d_filter.isEmpty() || name.contains( d_filter );
+}
+
+void Benchmark::printHeader()
+{
+    if ( d_format == Csv )
+    {
+        d_out << "case,width,height,frames,"
+            << "ms_per_frame,frames_per_second,"
+            << "samples_per_frame,points_per_frame,samples_per_second\n";
+        d_out.flush();
+    }
+}
+
+void Benchmark::run( const QString &name, QwtPlot *plot, Target target )
+{
+    if ( !accepts( name ) )
+        return;
+
+    plot->updateAxes();
+
+    for ( int i = 0; i < d_sizes.size(); i++ )
+    {
+        const QSize &size = d_sizes[i];
+
+        // warming up: filling caches, allocating buffers ...
+        if ( !renderFrame( plot, size, target ) )
+            return;
+
+        resetStatistics( plot );
+
+        QwtSystemClock clock;
+        clock.start();
+
+        for ( int frame = 0; frame < d_numFrames; frame++ )
+            renderFrame( plot, size, target );
+
+        const double elapsed = clock.elapsed();
+
+        size_t numSamples, numPoints;
+        getStatistics( plot, numSamples, numPoints );
+
+        report( name, size, elapsed, numSamples, numPoints );
+    }
+}
+
+bool Benchmark::renderFrame( QwtPlot *plot,
+    const QSize &size, Target target ) const
+{
+    const QRectF rect( QPointF( 0.0, 0.0 ), size );
+
+    QwtPlotRenderer renderer;
+
+    switch( target )
+    {
+        case Image:
+        {
+            QImage image( size, QImage::Format_ARGB32_Premultiplied );
+            image.fill( Qt::white );
+
+            QPainter painter( &image );
+            renderer.render( plot, &painter, rect );
+
+            return true;
+        }
+        case Graphic:
+        {
+            QwtGraphic graphic;
+            graphic.setDefaultSize( size );
+
+            QPainter painter( &graphic );
+            renderer.render( plot, &painter, rect );
+
+            return true;
+        }
+        case Svg:
+        {
+#ifndef QWT_NO_SVG
+            QBuffer buffer;
+            buffer.open( QIODevice::WriteOnly );
+
+            QSvgGenerator generator;
+            generator.setOutputDevice( &buffer );
+            generator.setSize( size );
+            generator.setViewBox( rect );
+
+            QPainter painter( &generator );
+            renderer.render( plot, &painter, rect );
+
+            return true;
+#else
+            return false;
+#endif
+        }
+        case Pdf:
+        {
+#ifndef QT_NO_PRINTER
+            const QString fileName =
+                QDir::tempPath() + "/qwt_benchmark.pdf";
+
+            {
+                QPrinter printer;
+                printer.setOutputFormat( QPrinter::PdfFormat );
+                printer.setOutputFileName( fileName );
+                printer.setFullPage( true );
+                printer.setPaperSize( size, QPrinter::DevicePixel );
+
+                QPainter painter( &printer );
+                renderer.render( plot, &painter, rect );
+            }
+
+            QFile::remove( fileName );
+
+            return true;
+#else
+            return false;
+#endif
+        }
+    }
+
+    return false;
+}
+
+void Benchmark::report( const QString &name, const QSize &size,
+    double elapsed, size_t numSamples, size_t numPoints )
+{
+    const double msPerFrame = elapsed / d_numFrames;
+    const double fps = ( elapsed > 0.0 ) ? 1000.0 * d_numFrames / elapsed : 0.0;
+    const double samplesPerFrame = double( numSamples ) / d_numFrames;
+    const double pointsPerFrame = double( numPoints ) / d_numFrames;
+    const double samplesPerSecond = ( elapsed > 0.0 )
+        ? 1000.0 * numSamples / elapsed : 0.0;
+
+    if ( d_format == Json )
+    {
+        d_out << "{ \"case\": \"" << name << "\""
+            << ", \"width\": " << size.width()
+            << ", \"height\": " << size.height()
+            << ", \"frames\": " << d_numFrames
+            << ", \"ms_per_frame\": " << msPerFrame
+            << ", \"frames_per_second\": " << fps
+            << ", \"samples_per_frame\": " << samplesPerFrame
+            << ", \"points_per_frame\": " << pointsPerFrame
+            << ", \"samples_per_second\": " << samplesPerSecond
+            << " }\n";
+    }
+    else
+    {
+        d_out << name << ',' << size.width() << ',' << size.height()
+            << ',' << d_numFrames << ',' << msPerFrame << ',' << fps
+            << ',' << samplesPerFrame << ',' << pointsPerFrame
+            << ',' << samplesPerSecond << '\n';
+    }
+
+    d_out.flush();
+}
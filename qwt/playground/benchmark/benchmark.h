@@ -0,0 +1,57 @@
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <qstring.h>
+#include <qsize.h>
+#include <qlist.h>
+#include <qtextstream.h>
+
+class QwtPlot;
+
+class Benchmark
+{
+public:
+    enum Format
+    {
+        Csv,
+        Json
+    };
+
+    enum Target
+    {
+        // QImage::Format_ARGB32_Premultiplied
+        Image,
+
+        // QwtPlotRenderer exports
+        Graphic,
+        Svg,
+        Pdf
+    };
+
+    Benchmark();
+
+    void setFormat( Format );
+    void setNumFrames( int );
+    void setSizes( const QList<QSize> & );
+    void setFilter( const QString & );
+
+    bool accepts( const QString &name ) const;
+
+    void printHeader();
+    void run( const QString &name, QwtPlot *, Target = Image );
+
+private:
+    bool renderFrame( QwtPlot *, const QSize &, Target ) const;
+
+    void report( const QString &name, const QSize &,
+        double elapsed, size_t numSamples, size_t numPoints );
+
+    Format d_format;
+    int d_numFrames;
+    QList<QSize> d_sizes;
+    QString d_filter;
+
+    QTextStream d_out;
+};
+
+#endif
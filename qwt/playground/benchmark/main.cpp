@@ -0,0 +1,408 @@
+#include <qapplication.h>
+#include <qstringlist.h>
+#include <qtextstream.h>
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_plot_grid.h>
+#include <qwt_plot_spectrogram.h>
+#include <qwt_matrix_raster_data.h>
+#include <qwt_color_map.h>
+#include <qwt_symbol.h>
+#include <qwt_math.h>
+#include <stdio.h>
+#include "benchmark.h"
+
+/*
+  A headless benchmark for the hot paths of the plot items.
+
+  All plots are rendered offscreen by QwtPlotRenderer - nothing is shown
+  on screen. On Qt5 the offscreen platform plugin is used, unless
+  QT_QPA_PLATFORM is set explicitly.
+
+  The results are written to stdout as CSV ( default ) or as one JSON
+  object per line ( -json ), so that they can be compared between builds.
+ */
+
+static QVector<QPointF> createSamples( int numPoints )
+{
+    // deterministic noise, so that runs are comparable
+
+    uint seed = 12345;
+
+    QVector<QPointF> samples( numPoints );
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        seed = seed * 1103515245 + 12345;
+        const double noise = ( ( seed >> 16 ) & 0x7fff ) / 32768.0 - 0.5;
+
+        const double x = i;
+        const double y = qSin( 20.0 * M_PI * x / numPoints ) + 0.2 * noise;
+
+        samples[i] = QPointF( x, y );
+    }
+
+    return samples;
+}
+
+static QwtPlot *createPlot()
+{
+    QwtPlot *plot = new QwtPlot();
+    plot->setAutoReplot( false );
+    plot->setTitle( "Benchmark" );
+
+    QwtPlotGrid *grid = new QwtPlotGrid();
+    grid->setPen( Qt::gray, 0.0, Qt::DotLine );
+    grid->attach( plot );
+
+    return plot;
+}
+
+static QwtPlot *createCurvePlot( int numPoints,
+    QwtPlotCurve::CurveStyle style, QwtPlotCurve::PaintAttributes attributes,
+    bool antialiased = false, bool filled = false )
+{
+    QwtPlot *plot = createPlot();
+
+    QwtPlotCurve *curve = new QwtPlotCurve( "Curve" );
+    curve->setStyle( style );
+    curve->setPen( Qt::darkBlue, 0.0 );
+    curve->setRenderHint( QwtPlotItem::RenderAntialiased, antialiased );
+
+    const QwtPlotCurve::PaintAttribute paintAttributes[] =
+    {
+        QwtPlotCurve::ClipPolygons,
+        QwtPlotCurve::FilterPoints,
+        QwtPlotCurve::FilterPointsAggressive,
+        QwtPlotCurve::ImageBuffer
+    };
+
+    for ( uint i = 0; i < sizeof( paintAttributes ) / sizeof( paintAttributes[0] ); i++ )
+    {
+        const QwtPlotCurve::PaintAttribute attribute = paintAttributes[i];
+        curve->setPaintAttribute( attribute, attributes & attribute );
+    }
+
+    if ( filled )
+    {
+        curve->setBaseline( -1.5 );
+        curve->setBrush( QColor( 200, 200, 255 ) );
+    }
+
+    curve->setSamples( createSamples( numPoints ) );
+    curve->attach( plot );
+
+    if ( attributes & QwtPlotCurve::ClipPolygons )
+    {
+        // zooming into the middle, so that most points need to be clipped
+        plot->setAxisScale( QwtPlot::xBottom,
+            0.4 * numPoints, 0.6 * numPoints );
+        plot->setAxisScale( QwtPlot::yLeft, -0.5, 0.5 );
+    }
+
+    return plot;
+}
+
+static QwtPlot *createSymbolPlot( int numPoints, QwtSymbol::Style style )
+{
+    QwtPlot *plot = createPlot();
+
+    QwtPlotCurve *curve = new QwtPlotCurve( "Symbols" );
+    curve->setStyle( QwtPlotCurve::NoCurve );
+    curve->setSymbol( new QwtSymbol( style,
+        QBrush( Qt::yellow ), QPen( Qt::darkBlue, 0.0 ), QSize( 7, 7 ) ) );
+    curve->setSamples( createSamples( numPoints ) );
+    curve->attach( plot );
+
+    return plot;
+}
+
+static QwtMatrixRasterData *createRasterData( int numColumns, int numRows )
+{
+    QVector<double> values( numColumns * numRows );
+    for ( int row = 0; row < numRows; row++ )
+    {
+        const double y = -1.5 + 3.0 * row / numRows;
+
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            const double x = -1.5 + 3.0 * col / numColumns;
+
+            const double c = 0.842;
+            const double v1 = x * x + ( y - c ) * ( y + c );
+            const double v2 = 2.0 * x * ( y + c );
+
+            values[ row * numColumns + col ] =
+                qMin( 1.0 / ( v1 * v1 + v2 * v2 ), 10.0 );
+        }
+    }
+
+    QwtMatrixRasterData *data = new QwtMatrixRasterData();
+    data->setValueMatrix( values, numColumns );
+    data->setInterval( Qt::XAxis, QwtInterval( -1.5, 1.5 ) );
+    data->setInterval( Qt::YAxis, QwtInterval( -1.5, 1.5 ) );
+    data->setInterval( Qt::ZAxis, QwtInterval( 0.0, 10.0 ) );
+
+    return data;
+}
+
+static QwtPlot *createSpectrogramPlot(
+    QwtMatrixRasterData::ResampleMode resampleMode,
+    QwtColorMap::Format format, bool contours )
+{
+    QwtPlot *plot = createPlot();
+
+    QwtMatrixRasterData *data = createRasterData( 500, 500 );
+    data->setResampleMode( resampleMode );
+
+    QwtLinearColorMap *colorMap =
+        new QwtLinearColorMap( Qt::darkCyan, Qt::red, format );
+    colorMap->addColorStop( 0.1, Qt::cyan );
+    colorMap->addColorStop( 0.6, Qt::green );
+    colorMap->addColorStop( 0.95, Qt::yellow );
+
+    QwtPlotSpectrogram *spectrogram = new QwtPlotSpectrogram();
+    spectrogram->setRenderThreadCount( 0 ); // use system specific thread count
+    spectrogram->setColorMap( colorMap );
+    spectrogram->setData( data );
+
+    if ( contours )
+    {
+        QList<double> levels;
+        for ( double level = 0.5; level < 10.0; level += 1.0 )
+            levels += level;
+
+        spectrogram->setContourLevels( levels );
+        spectrogram->setDisplayMode( QwtPlotSpectrogram::ContourMode, true );
+        spectrogram->setDisplayMode( QwtPlotSpectrogram::ImageMode, false );
+    }
+
+    spectrogram->attach( plot );
+
+    return plot;
+}
+
+static void runCurves( Benchmark &benchmark, int numPoints )
+{
+    const struct
+    {
+        const char *name;
+        QwtPlotCurve::CurveStyle style;
+        QwtPlotCurve::PaintAttributes attributes;
+        bool antialiased;
+        bool filled;
+    } cases[] =
+    {
+        { "curve-lines", QwtPlotCurve::Lines, 0, false, false },
+        { "curve-lines-antialiased", QwtPlotCurve::Lines, 0, true, false },
+        { "curve-lines-filled", QwtPlotCurve::Lines, 0, false, true },
+        { "curve-lines-filter", QwtPlotCurve::Lines,
+            QwtPlotCurve::FilterPoints, false, false },
+        { "curve-lines-filter-aggressive", QwtPlotCurve::Lines,
+            QwtPlotCurve::FilterPointsAggressive, false, false },
+        { "curve-lines-clip", QwtPlotCurve::Lines,
+            QwtPlotCurve::ClipPolygons, false, false },
+        { "curve-sticks", QwtPlotCurve::Sticks, 0, false, false },
+        { "curve-steps", QwtPlotCurve::Steps, 0, false, false },
+        { "curve-steps-clip", QwtPlotCurve::Steps,
+            QwtPlotCurve::ClipPolygons, false, false },
+        { "curve-dots", QwtPlotCurve::Dots, 0, false, false },
+        { "curve-dots-filter", QwtPlotCurve::Dots,
+            QwtPlotCurve::FilterPoints, false, false },
+        { "curve-dots-imagebuffer", QwtPlotCurve::Dots,
+            QwtPlotCurve::ImageBuffer, false, false },
+        { "curve-dots-imagebuffer-antialiased", QwtPlotCurve::Dots,
+            QwtPlotCurve::ImageBuffer, true, false }
+    };
+
+    for ( uint i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ )
+    {
+        if ( !benchmark.accepts( cases[i].name ) )
+            continue;
+
+        QwtPlot *plot = createCurvePlot( numPoints, cases[i].style,
+            cases[i].attributes, cases[i].antialiased, cases[i].filled );
+
+        benchmark.run( cases[i].name, plot );
+
+        delete plot;
+    }
+}
+
+static void runSymbols( Benchmark &benchmark, int numPoints )
+{
+    const struct
+    {
+        const char *name;
+        QwtSymbol::Style style;
+    } cases[] =
+    {
+        { "symbol-ellipse", QwtSymbol::Ellipse },
+        { "symbol-rect", QwtSymbol::Rect },
+        { "symbol-diamond", QwtSymbol::Diamond },
+        { "symbol-triangle", QwtSymbol::Triangle },
+        { "symbol-cross", QwtSymbol::Cross },
+        { "symbol-xcross", QwtSymbol::XCross },
+        { "symbol-star", QwtSymbol::Star1 },
+        { "symbol-hexagon", QwtSymbol::Hexagon }
+    };
+
+    for ( uint i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ )
+    {
+        if ( !benchmark.accepts( cases[i].name ) )
+            continue;
+
+        QwtPlot *plot = createSymbolPlot( numPoints, cases[i].style );
+        benchmark.run( cases[i].name, plot );
+
+        delete plot;
+    }
+}
+
+static void runSpectrograms( Benchmark &benchmark )
+{
+    const struct
+    {
+        const char *name;
+        QwtMatrixRasterData::ResampleMode resampleMode;
+        QwtColorMap::Format format;
+        bool contours;
+    } cases[] =
+    {
+        { "spectrogram-nearest-rgb",
+            QwtMatrixRasterData::NearestNeighbour, QwtColorMap::RGB, false },
+        { "spectrogram-nearest-indexed",
+            QwtMatrixRasterData::NearestNeighbour, QwtColorMap::Indexed, false },
+        { "spectrogram-bilinear-rgb",
+            QwtMatrixRasterData::BilinearInterpolation, QwtColorMap::RGB, false },
+        { "spectrogram-bilinear-indexed",
+            QwtMatrixRasterData::BilinearInterpolation, QwtColorMap::Indexed, false },
+        { "contours",
+            QwtMatrixRasterData::NearestNeighbour, QwtColorMap::RGB, true }
+    };
+
+    for ( uint i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ )
+    {
+        if ( !benchmark.accepts( cases[i].name ) )
+            continue;
+
+        QwtPlot *plot = createSpectrogramPlot( cases[i].resampleMode,
+            cases[i].format, cases[i].contours );
+
+        benchmark.run( cases[i].name, plot );
+
+        delete plot;
+    }
+}
+
+static void runExports( Benchmark &benchmark, int numPoints )
+{
+    const struct
+    {
+        const char *name;
+        Benchmark::Target target;
+    } cases[] =
+    {
+        { "export-graphic", Benchmark::Graphic },
+        { "export-svg", Benchmark::Svg },
+        { "export-pdf", Benchmark::Pdf }
+    };
+
+    for ( uint i = 0; i < sizeof( cases ) / sizeof( cases[0] ); i++ )
+    {
+        if ( !benchmark.accepts( cases[i].name ) )
+            continue;
+
+        QwtPlot *plot = createCurvePlot( numPoints, QwtPlotCurve::Lines, 0 );
+        benchmark.run( cases[i].name, plot, cases[i].target );
+
+        delete plot;
+    }
+}
+
+static bool parseSize( const QString &text, QSize &size )
+{
+    const QStringList values = text.split( 'x' );
+    if ( values.size() != 2 )
+        return false;
+
+    bool ok1, ok2;
+    size = QSize( values[0].toInt( &ok1 ), values[1].toInt( &ok2 ) );
+
+    return ok1 && ok2 && !size.isEmpty();
+}
+
+static int usage( const char *appName )
+{
+    fprintf( stderr, "Usage: %s [options]\n"
+        "  -frames <n>       Number of frames per case ( default: 20 )\n"
+        "  -points <n>       Number of curve points ( default: 100000 )\n"
+        "  -size <w>x<h>     Image size, might be repeated ( default: 800x600 )\n"
+        "  -filter <text>    Run the cases containing text only\n"
+        "  -json             One JSON object per line instead of CSV\n",
+        appName );
+
+    return 1;
+}
+
+int main( int argc, char **argv )
+{
+#if QT_VERSION >= 0x050100
+    if ( !qEnvironmentVariableIsSet( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+#endif
+
+    QApplication a( argc, argv );
+
+    Benchmark benchmark;
+
+    int numPoints = 100000;
+    QList<QSize> sizes;
+
+    const QStringList args = a.arguments();
+    for ( int i = 1; i < args.size(); i++ )
+    {
+        const QString &arg = args[i];
+        const bool hasValue = ( i + 1 < args.size() );
+
+        if ( arg == "-json" )
+        {
+            benchmark.setFormat( Benchmark::Json );
+        }
+        else if ( arg == "-frames" && hasValue )
+        {
+            benchmark.setNumFrames( args[++i].toInt() );
+        }
+        else if ( arg == "-points" && hasValue )
+        {
+            numPoints = qMax( args[++i].toInt(), 2 );
+        }
+        else if ( arg == "-filter" && hasValue )
+        {
+            benchmark.setFilter( args[++i] );
+        }
+        else if ( arg == "-size" && hasValue )
+        {
+            QSize size;
+            if ( !parseSize( args[++i], size ) )
+                return usage( argv[0] );
+
+            sizes += size;
+        }
+        else
+        {
+            return usage( argv[0] );
+        }
+    }
+
+    if ( !sizes.isEmpty() )
+        benchmark.setSizes( sizes );
+
+    benchmark.printHeader();
+
+    runCurves( benchmark, numPoints );
+    runSymbols( benchmark, numPoints / 10 );
+    runSpectrograms( benchmark );
+    runExports( benchmark, numPoints );
+
+    return 0;
+}
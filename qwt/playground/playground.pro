@@ -22,7 +22,8 @@ contains(QWT_CONFIG, QwtPlot) {
         shapes \
         curvetracker \
         symbols \
-        splinetest
+        splinetest \
+        benchmark
 
     contains(QWT_CONFIG, QwtSvg) {
 
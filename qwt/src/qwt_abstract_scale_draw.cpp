@@ -15,6 +15,7 @@
 #include <qpainter.h>
 #include <qpalette.h>
 #include <qmap.h>
+#include <qcache.h>
 #include <qlocale.h>
 
 class QwtAbstractScaleDraw::PrivateData
@@ -23,7 +24,8 @@ public:
     PrivateData():
         spacing( 4.0 ),
         penWidth( 0 ),
-        minExtent( 0.0 )
+        minExtent( 0.0 ),
+        textCache( 500 )
     {
         components = QwtAbstractScaleDraw::Backbone 
             | QwtAbstractScaleDraw::Ticks 
@@ -45,7 +47,11 @@ public:
 
     double minExtent;
 
+    // labels of the ticks of the current scale division
     QMap<double, QwtText> labelCache;
+
+    // formatted and measured labels of all scale divisions
+    QCache<QString, QwtText> textCache;
 };
 
 /*!
@@ -384,10 +390,19 @@ QwtText QwtAbstractScaleDraw::label( double value ) const
    calculation of the label sizes might be slow (really slow
    for rich text in Qt4), so it's necessary to cache the labels.
 
+   The labels of the current scale division are cached by their
+   values. As the values usually change with each new scale
+   division - f.e. when panning - the formatted and measured
+   labels are also kept in a second cache, that is indexed by
+   the label text and the font. This cache survives
+   setScaleDiv() and is limited to labelCacheSize() entries,
+   discarding the least recently used labels.
+
    \param font Font
    \param value Value
 
    \return Tick label
+   \sa setLabelCacheSize(), invalidateCache()
 */
 const QwtText &QwtAbstractScaleDraw::tickLabel(
     const QFont &font, double value ) const
@@ -399,7 +414,19 @@ const QwtText &QwtAbstractScaleDraw::tickLabel(
         lbl.setRenderFlags( 0 );
         lbl.setLayoutAttribute( QwtText::MinimumLayout );
 
-        ( void )lbl.textSize( font ); // initialize the internal cache
+        const QString key = font.key() + QLatin1Char( '\n' ) + lbl.text();
+
+        const QwtText *cachedLabel = d_data->textCache.object( key );
+        if ( cachedLabel && *cachedLabel == lbl )
+        {
+            // the size of the text has already been calculated
+            lbl = *cachedLabel;
+        }
+        else
+        {
+            ( void )lbl.textSize( font ); // initialize the internal cache
+            d_data->textCache.insert( key, new QwtText( lbl ) );
+        }
 
         it = d_data->labelCache.insert( value, lbl );
     }
@@ -413,8 +440,35 @@ const QwtText &QwtAbstractScaleDraw::tickLabel(
    The cache is invalidated, when a new QwtScaleDiv is set. If
    the labels need to be changed. while the same QwtScaleDiv is set,
    invalidateCache() needs to be called manually.
+
+   \note The cache of the formatted labels, that survives
+         setScaleDiv(), is cleared too
 */
 void QwtAbstractScaleDraw::invalidateCache()
 {
     d_data->labelCache.clear();
+    d_data->textCache.clear();
+}
+
+/*!
+   Set the maximum number of labels, that are kept in a cache
+   beyond the current scale division.
+
+   \param numLabels Maximum number of labels. 0 disables the cache.
+   \sa labelCacheSize(), tickLabel()
+*/
+void QwtAbstractScaleDraw::setLabelCacheSize( int numLabels )
+{
+    d_data->textCache.setMaxCost( qMax( numLabels, 0 ) );
+}
+
+/*!
+   \return Maximum number of labels, that are kept in a cache
+           beyond the current scale division. The default
+           setting is 500.
+   \sa setLabelCacheSize(), tickLabel()
+*/
+int QwtAbstractScaleDraw::labelCacheSize() const
+{
+    return d_data->textCache.maxCost();
 }
@@ -97,6 +97,9 @@ public:
 
     void invalidateCache();
 
+    void setLabelCacheSize( int numLabels );
+    int labelCacheSize() const;
+
 protected:
     /*!
        Draw a tick
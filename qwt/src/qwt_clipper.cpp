@@ -10,8 +10,6 @@
 #include "qwt_clipper.h"
 #include "qwt_point_polar.h"
 #include <qrect.h>
-#include <string.h>
-#include <stdlib.h>
 
 #if QT_VERSION < 0x040601
 #define qAtan(x) ::atan(x)
@@ -25,7 +23,8 @@ namespace QwtClip
     template <class Point, typename T> class TopEdge;
     template <class Point, typename T> class BottomEdge;
 
-    template <class Point> class PointBuffer;
+    template <class Polygon, class Point> class PointSink;
+    template <class Point, class Edge, class Next> class EdgeClipper;
 }
 
 template <class Point, typename Value>
@@ -123,82 +122,140 @@ private:
     const Value d_y2;
 };
 
-template<class Point>
-class QwtClip::PointBuffer
+template <class Polygon, class Point>
+class QwtClip::PointSink
 {
 public:
-    PointBuffer( int capacity = 0 ):
-        m_capacity( 0 ),
-        m_size( 0 ),
-        m_buffer( NULL )
+    inline PointSink():
+        d_polygon( NULL ),
+        d_points( NULL ),
+        d_size( 0 ),
+        d_capacity( 0 )
     {
-        if ( capacity > 0 )
-            reserve( capacity );
     }
 
-    ~PointBuffer()
+    inline void begin( Polygon *polygon )
     {
-        if ( m_buffer )
-            ::free( m_buffer );
+        // the points of the polygon are reused as buffer
+
+        d_polygon = polygon;
+        d_size = 0;
+        d_capacity = polygon->size();
+        d_points = ( d_capacity > 0 ) ? polygon->data() : NULL;
     }
 
-    inline void setPoints( int numPoints, const Point *points )
+    inline void add( const Point &point )
     {
-        reserve( numPoints );
+        if ( d_size >= d_capacity )
+        {
+            d_capacity = qMax( 2 * d_capacity, 64 );
 
-        m_size = numPoints;
-        ::memcpy( m_buffer, points, m_size * sizeof( Point ) );
-    }
+            d_polygon->resize( d_capacity );
+            d_points = d_polygon->data();
+        }
 
-    inline void reset() 
-    { 
-        m_size = 0; 
+        d_points[d_size++] = point;
     }
 
-    inline int size() const 
-    { 
-        return m_size; 
+    inline int size() const
+    {
+        return d_size;
     }
 
-    inline Point *data() const 
-    { 
-        return m_buffer; 
+    inline void end()
+    {
+        d_polygon->resize( d_size );
     }
 
-    inline Point &operator[]( int i ) 
-    { 
-        return m_buffer[i]; 
+private:
+    Polygon *d_polygon;
+    Point *d_points;
+    int d_size;
+    int d_capacity;
+};
+
+/*
+  One stage of the Sutherland-Hodgman algorithm, passing
+  its output to the next stage without any buffering
+ */
+template <class Point, class Edge, class Next>
+class QwtClip::EdgeClipper
+{
+public:
+    inline EdgeClipper( const Edge &edge, Next &next ):
+        d_edge( edge ),
+        d_next( next ),
+        d_closed( false ),
+        d_count( 0 ),
+        d_lastInside( false )
+    {
     }
 
-    inline const Point &operator[]( int i ) const 
-    { 
-        return m_buffer[i]; 
+    inline void begin( bool closePolygon )
+    {
+        d_closed = closePolygon;
+        d_count = 0;
     }
 
     inline void add( const Point &point )
     {
-        if ( m_capacity <= m_size )
-            reserve( m_size + 1 );
+        const bool inside = d_edge.isInside( point );
 
-        m_buffer[m_size++] = point;
+        if ( d_count++ == 0 )
+        {
+            d_first = point;
+
+            if ( !d_closed && inside )
+                d_next.add( point );
+        }
+        else
+        {
+            clip( point, inside );
+        }
+
+        d_last = point;
+        d_lastInside = inside;
     }
 
-private:
-    inline void reserve( int size )
+    inline void end()
     {
-        if ( m_capacity == 0 )
-            m_capacity = 1;
+        if ( d_count == 1 )
+        {
+            // a single point has never been clipped
+            if ( d_closed || !d_lastInside )
+                d_next.add( d_first );
+        }
+        else if ( d_closed && d_count > 1 )
+        {
+            clip( d_first, d_edge.isInside( d_first ) );
+        }
+    }
 
-        while ( m_capacity < size )
-            m_capacity *= 2;
+private:
+    inline void clip( const Point &p1, bool inside )
+    {
+        if ( inside )
+        {
+            if ( !d_lastInside )
+                d_next.add( d_edge.intersection( p1, d_last ) );
 
-        m_buffer = static_cast<Point *>( 
-            ::realloc( m_buffer, m_capacity * sizeof( Point ) ) );
+            d_next.add( p1 );
+        }
+        else if ( d_lastInside )
+        {
+            d_next.add( d_edge.intersection( p1, d_last ) );
+        }
     }
 
-    int m_capacity;
-    int m_size;
-    Point *m_buffer;
+    const Edge d_edge;
+    Next &d_next;
+
+    bool d_closed;
+    int d_count;
+
+    Point d_first;
+    Point d_last;
+    bool d_lastInside;
 };
 
 using namespace QwtClip;
@@ -206,98 +263,209 @@ using namespace QwtClip;
 template <class Polygon, class Rect, class Point, typename T>
 class QwtPolygonClipper
 {
+    typedef PointSink<Polygon, Point> Sink;
+
+    typedef EdgeClipper< Point, BottomEdge<Point, T>, Sink > BottomClipper;
+    typedef EdgeClipper< Point, TopEdge<Point, T>, BottomClipper > TopClipper;
+    typedef EdgeClipper< Point, RightEdge<Point, T>, TopClipper > RightClipper;
+    typedef EdgeClipper< Point, LeftEdge<Point, T>, RightClipper > LeftClipper;
+
 public:
     QwtPolygonClipper( const Rect &clipRect ):
-        d_clipRect( clipRect )
+        d_bottom( BottomEdge<Point, T>( x1( clipRect ), x2( clipRect ), 
+            y1( clipRect ), y2( clipRect ) ), d_sink ),
+        d_top( TopEdge<Point, T>( x1( clipRect ), x2( clipRect ), 
+            y1( clipRect ), y2( clipRect ) ), d_bottom ),
+        d_right( RightEdge<Point, T>( x1( clipRect ), x2( clipRect ), 
+            y1( clipRect ), y2( clipRect ) ), d_top ),
+        d_left( LeftEdge<Point, T>( x1( clipRect ), x2( clipRect ), 
+            y1( clipRect ), y2( clipRect ) ), d_right )
     {
     }
 
-    Polygon clipPolygon( const Polygon &polygon, bool closePolygon ) const
+    Polygon clipPolygon( const Polygon &polygon, bool closePolygon )
     {
-#if 0
-        if ( d_clipRect.contains( polygon.boundingRect() ) )
-            return polygon;
-#endif
+        Polygon clipped;
 
-        PointBuffer<Point> points1;
-        PointBuffer<Point> points2( qMin( 256, polygon.size() ) );
+        begin( &clipped, closePolygon );
+        add( polygon.constData(), polygon.size() );
+        end();
 
-        points1.setPoints( polygon.size(), polygon.data() );
+        return clipped;
+    }
 
-        clipEdge< LeftEdge<Point, T> >( closePolygon, points1, points2 );
-        clipEdge< RightEdge<Point, T> >( closePolygon, points2, points1 );
-        clipEdge< TopEdge<Point, T> >( closePolygon, points1, points2 );
-        clipEdge< BottomEdge<Point, T> >( closePolygon, points2, points1 );
+    inline void begin( Polygon *clipped, bool closePolygon )
+    {
+        d_sink.begin( clipped );
 
-        Polygon p;
-        p.resize( points1.size() );
-        ::memcpy( p.data(), points1.data(), points1.size() * sizeof( Point ) );
+        d_left.begin( closePolygon );
+        d_right.begin( closePolygon );
+        d_top.begin( closePolygon );
+        d_bottom.begin( closePolygon );
+    }
 
-        return p;
+    inline void add( const Point &point )
+    {
+        d_left.add( point );
+    }
+
+    inline void add( const Point *points, int numPoints )
+    {
+        for ( int i = 0; i < numPoints; i++ )
+            d_left.add( points[i] );
+    }
+
+    inline void end()
+    {
+        // the stages need to be flushed in the order of the pipeline
+
+        d_left.end();
+        d_right.end();
+        d_top.end();
+        d_bottom.end();
+
+        d_sink.end();
     }
 
 private:
-    template <class Edge>
-    inline void clipEdge( bool closePolygon,
-        PointBuffer<Point> &points, PointBuffer<Point> &clippedPoints ) const
+    static inline T x1( const Rect &r ) { return r.x(); }
+    static inline T x2( const Rect &r ) { return r.x() + r.width(); }
+    static inline T y1( const Rect &r ) { return r.y(); }
+    static inline T y2( const Rect &r ) { return r.y() + r.height(); }
+
+    Sink d_sink;
+
+    BottomClipper d_bottom;
+    TopClipper d_top;
+    RightClipper d_right;
+    LeftClipper d_left;
+};
+
+static inline bool qwtClipT( double p, double q, double &t0, double &t1 )
+{
+    // Liang-Barsky
+
+    if ( p == 0.0 )
+        return q >= 0.0;
+
+    const double r = q / p;
+
+    if ( p < 0.0 )
     {
-        clippedPoints.reset();
+        if ( r > t1 )
+            return false;
 
-        if ( points.size() < 2 )
-        {
-            if ( points.size() == 1 )
-                clippedPoints.add( points[0] );
-            return;
-        }
+        if ( r > t0 )
+            t0 = r;
+    }
+    else
+    {
+        if ( r < t0 )
+            return false;
 
-        const Edge edge( d_clipRect.x(), d_clipRect.x() + d_clipRect.width(),
-            d_clipRect.y(), d_clipRect.y() + d_clipRect.height() );
+        if ( r < t1 )
+            t1 = r;
+    }
 
-        int lastPos, start;
-        if ( closePolygon )
-        {
-            start = 0;
-            lastPos = points.size() - 1;
-        }
-        else
-        {
-            start = 1;
-            lastPos = 0;
+    return true;
+}
 
-            if ( edge.isInside( points[0] ) )
-                clippedPoints.add( points[0] );
-        }
+/*
+  Clipping the lines between the points, so that the visible
+  parts end up in separate runs
+ */
+class QwtPolylineClipper
+{
+public:
+    QwtPolylineClipper( const QRectF &clipRect ):
+        d_x1( clipRect.left() ),
+        d_x2( clipRect.right() ),
+        d_y1( clipRect.top() ),
+        d_y2( clipRect.bottom() ),
+        d_runs( NULL ),
+        d_count( 0 ),
+        d_isOpen( false )
+    {
+    }
 
-        const uint nPoints = points.size();
-        for ( uint i = start; i < nPoints; i++ )
-        {
-            const Point &p1 = points[i];
-            const Point &p2 = points[lastPos];
+    inline void begin( QPolygonF *clipped, QVector<int> *runs )
+    {
+        d_sink.begin( clipped );
+
+        d_runs = runs;
+        if ( d_runs )
+            d_runs->resize( 0 );
+
+        d_count = 0;
+        d_isOpen = false;
+    }
+
+    inline void add( const QPointF &point )
+    {
+        if ( d_count++ > 0 )
+            clipLine( d_last, point );
+
+        d_last = point;
+    }
+
+    inline void end()
+    {
+        d_sink.end();
+    }
 
-            if ( edge.isInside( p1 ) )
+private:
+    inline void clipLine( const QPointF &p1, const QPointF &p2 )
+    {
+        const double dx = p2.x() - p1.x();
+        const double dy = p2.y() - p1.y();
+
+        double t0 = 0.0;
+        double t1 = 1.0;
+
+        if ( qwtClipT( -dx, p1.x() - d_x1, t0, t1 )
+            && qwtClipT( dx, d_x2 - p1.x(), t0, t1 )
+            && qwtClipT( -dy, p1.y() - d_y1, t0, t1 )
+            && qwtClipT( dy, d_y2 - p1.y(), t0, t1 ) )
+        {
+            if ( !d_isOpen || t0 > 0.0 )
             {
-                if ( edge.isInside( p2 ) )
-                {
-                    clippedPoints.add( p1 );
-                }
+                if ( d_runs )
+                    *d_runs += d_sink.size();
+
+                if ( t0 > 0.0 )
+                    d_sink.add( QPointF( p1.x() + t0 * dx, p1.y() + t0 * dy ) );
                 else
-                {
-                    clippedPoints.add( edge.intersection( p1, p2 ) );
-                    clippedPoints.add( p1 );
-                }
+                    d_sink.add( p1 );
+            }
+
+            if ( t1 < 1.0 )
+            {
+                d_sink.add( QPointF( p1.x() + t1 * dx, p1.y() + t1 * dy ) );
+                d_isOpen = false;
             }
             else
             {
-                if ( edge.isInside( p2 ) )
-                {
-                    clippedPoints.add( edge.intersection( p1, p2 ) );
-                }
+                d_sink.add( p2 );
+                d_isOpen = true;
             }
-            lastPos = i;
+        }
+        else
+        {
+            d_isOpen = false;
         }
     }
 
-    const Rect d_clipRect;
+    const double d_x1;
+    const double d_x2;
+    const double d_y1;
+    const double d_y2;
+
+    PointSink<QPolygonF, QPointF> d_sink;
+    QVector<int> *d_runs;
+
+    int d_count;
+    QPointF d_last;
+    bool d_isOpen;
 };
 
 class QwtCircleClipper
@@ -489,6 +657,46 @@ QPolygonF QwtClipper::clipPolygonF(
     return clipper.clipPolygon( polygon, closePolygon );
 }
 
+/*!
+   Clip a polyline, so that only its visible parts remain
+
+   In opposite to clipPolygonF() no lines along the borders of 
+   the clip rectangle are inserted, where the polyline leaves and 
+   reenters the rectangle. Instead the polyline is split into 
+   separate runs.
+
+   \param clipRect Clip rectangle
+   \param polyline Polyline
+
+   \return Visible runs of the polyline
+   \sa QwtStreamingClipper
+*/
+QVector<QPolygonF> QwtClipper::clipPolyline( 
+    const QRectF &clipRect, const QPolygonF &polyline )
+{
+    QPolygonF points;
+    QVector<int> runs;
+
+    QwtPolylineClipper clipper( clipRect );
+    clipper.begin( &points, &runs );
+
+    for ( int i = 0; i < polyline.size(); i++ )
+        clipper.add( polyline[i] );
+
+    clipper.end();
+
+    QVector<QPolygonF> polylines( runs.size() );
+    for ( int i = 0; i < runs.size(); i++ )
+    {
+        const int from = runs[i];
+        const int to = ( i < runs.size() - 1 ) ? runs[i + 1] : points.size();
+
+        polylines[i] = points.mid( from, to - from );
+    }
+
+    return polylines;
+}
+
 /*!
    Circle clipping
 
@@ -508,3 +716,125 @@ QVector<QwtInterval> QwtClipper::clipCircle( const QRectF &clipRect,
     QwtCircleClipper clipper( clipRect );
     return clipper.clipCircle( center, radius );
 }
+
+class QwtStreamingClipper::PrivateData
+{
+public:
+    PrivateData( const QRectF &clipRect, QwtStreamingClipper::Mode clipMode ):
+        mode( clipMode ),
+        polygonClipper( clipRect ),
+        polylineClipper( clipRect )
+    {
+    }
+
+    const QwtStreamingClipper::Mode mode;
+
+    QwtPolygonClipper<QPolygonF, QRectF, QPointF, double> polygonClipper;
+    QwtPolylineClipper polylineClipper;
+};
+
+/*!
+  Constructor
+
+  \param clipRect Clip rectangle
+  \param mode Clip mode
+ */
+QwtStreamingClipper::QwtStreamingClipper( 
+    const QRectF &clipRect, Mode mode )
+{
+    d_data = new PrivateData( clipRect, mode );
+}
+
+//! Destructor
+QwtStreamingClipper::~QwtStreamingClipper()
+{
+    delete d_data;
+}
+
+//! \return Clip mode
+QwtStreamingClipper::Mode QwtStreamingClipper::mode() const
+{
+    return d_data->mode;
+}
+
+/*!
+  \brief Start a new sequence of points
+
+  The points of the clipped polygon/polyline are written to 
+  clipped, starting at index 0. As the points of clipped are 
+  overwritten, it can be reused as buffer for several sequences 
+  without reallocating memory.
+
+  In Polyline mode the start indices of the visible runs are 
+  written to runs.
+
+  \param clipped Buffer for the clipped points
+  \param runs Buffer for the start indices of the runs, might be NULL
+
+  \sa addPoint(), addPoints(), end()
+ */
+void QwtStreamingClipper::begin( QPolygonF *clipped, QVector<int> *runs )
+{
+    if ( d_data->mode == Polyline )
+    {
+        d_data->polylineClipper.begin( clipped, runs );
+    }
+    else
+    {
+        d_data->polygonClipper.begin( clipped, d_data->mode == ClosedPolygon );
+
+        if ( runs )
+            runs->resize( 0 );
+    }
+}
+
+/*!
+  Pass the next point of a sequence to the clipper
+
+  \param point Point
+  \sa addPoints(), begin(), end()
+ */
+void QwtStreamingClipper::addPoint( const QPointF &point )
+{
+    if ( d_data->mode == Polyline )
+        d_data->polylineClipper.add( point );
+    else
+        d_data->polygonClipper.add( point );
+}
+
+/*!
+  Pass the next points of a sequence to the clipper
+
+  \param points Points
+  \param numPoints Number of points
+  \sa addPoint(), begin(), end()
+ */
+void QwtStreamingClipper::addPoints( const QPointF *points, int numPoints )
+{
+    if ( d_data->mode == Polyline )
+    {
+        for ( int i = 0; i < numPoints; i++ )
+            d_data->polylineClipper.add( points[i] );
+    }
+    else
+    {
+        d_data->polygonClipper.add( points, numPoints );
+    }
+}
+
+/*!
+  Finish the sequence, started with begin()
+
+  When closing a polygon the final points are written
+  and the buffer passed in begin() is resized to the 
+  number of clipped points.
+
+  \sa begin()
+ */
+void QwtStreamingClipper::end()
+{
+    if ( d_data->mode == Polyline )
+        d_data->polylineClipper.end();
+    else
+        d_data->polygonClipper.end();
+}
@@ -33,8 +33,73 @@ public:
     static QPolygonF clipPolygonF( const QRectF &, 
         const QPolygonF &, bool closePolygon = false );
 
+    static QVector<QPolygonF> clipPolyline( 
+        const QRectF &, const QPolygonF & );
+
     static QVector<QwtInterval> clipCircle(
         const QRectF &, const QPointF &, double radius );
 };
 
+/*!
+  \brief A clipper processing a sequence of points one by one
+
+  QwtStreamingClipper clips the points in a single pass, 
+  without copying them into temporary buffers. So it can be
+  fed directly from the loop, that maps the points into
+  paint device coordinates ( see QwtPointMapper::toClippedPolygonF() ).
+
+  \code
+    QPolygonF points; // might be reused for the next sequence
+    QVector<int> runs;
+
+    QwtStreamingClipper clipper( clipRect, QwtStreamingClipper::Polyline );
+
+    clipper.begin( &points, &runs );
+    for ( ... )
+        clipper.addPoint( ... );
+    clipper.end();
+  \endcode
+
+  \sa QwtClipper
+*/
+class QWT_EXPORT QwtStreamingClipper
+{
+public:
+    //! Clip mode
+    enum Mode
+    {
+        //! Sutherland-Hodgman clipping of a polygon, that is not closed
+        OpenPolygon,
+
+        //! Sutherland-Hodgman clipping of a closed polygon
+        ClosedPolygon,
+
+        /*! 
+          Split a polyline into runs of visible lines, instead 
+          of connecting them along the border of the clip rectangle
+         */
+        Polyline
+    };
+
+    explicit QwtStreamingClipper( const QRectF &clipRect, Mode = OpenPolygon );
+    ~QwtStreamingClipper();
+
+    Mode mode() const;
+
+    void begin( QPolygonF *clipped, QVector<int> *runs = NULL );
+
+    void addPoint( const QPointF & );
+    void addPoints( const QPointF *, int numPoints );
+
+    void end();
+
+private:
+    // Disabled copy constructor and operator=
+    QwtStreamingClipper( const QwtStreamingClipper & );
+    QwtStreamingClipper &operator=( const QwtStreamingClipper & );
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
 #endif
@@ -14,7 +14,8 @@
    \param mode Preferred fitting mode
  */
 QwtCurveFitter::QwtCurveFitter( Mode mode ):
-    d_mode( mode )
+    d_mode( mode ),
+    d_revision( 0 )
 {
 }
 
@@ -28,3 +29,33 @@ QwtCurveFitter::Mode QwtCurveFitter::mode() const
 {
     return d_mode;
 }
+
+/*!
+  \brief Revision of the fitter configuration
+
+  The revision is incremented by invalidate() and allows
+  to detect, that fitting results, that have been cached 
+  somewhere else ( f.e. QwtPlotCurve::CacheFittedCurve )
+  are outdated.
+
+  \return Revision of the fitter configuration
+  \sa invalidate()
+ */
+uint QwtCurveFitter::revision() const
+{
+    return d_revision;
+}
+
+/*!
+  \brief Indicate, that the configuration of the fitter has changed
+
+  All setters of the fitters implemented in Qwt call invalidate().
+  Derived classes have to call it, whenever a parameter
+  is modified, that has an effect on the result of the fitter.
+
+  \sa revision()
+ */
+void QwtCurveFitter::invalidate()
+{
+    d_revision++;
+}
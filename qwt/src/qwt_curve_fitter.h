@@ -51,6 +51,9 @@ public:
 
     Mode mode() const;
 
+    uint revision() const;
+    void invalidate();
+
     /*!
         Find a curve which has the best fit to a series of data points
 
@@ -79,6 +82,7 @@ private:
     QwtCurveFitter &operator=( const QwtCurveFitter & );
 
     const Mode d_mode;
+    uint d_revision;
 };
 
 #endif
@@ -11,6 +11,9 @@
 #include "qwt_math.h"
 #include "qwt_transform.h"
 #include <qdatetime.h>
+#include <qvector.h>
+#include <qmutex.h>
+#include <qalgorithms.h>
 #include <limits.h>
 
 static inline double qwtMsecsForType( QwtDate::IntervalType type )
@@ -444,6 +447,85 @@ static QList<double> qwtDstTicks( const QDateTime &dateTime,
     return ticks;
 }
 
+static inline bool qwtHasDaylightSaving( const QDateTime &minDate,
+    double stepSize, QwtDate::IntervalType intervalType )
+{
+    bool daylightSaving = false;
+    if ( minDate.timeSpec() == Qt::LocalTime )
+    {
+        daylightSaving = intervalType > QwtDate::Hour;
+        if ( intervalType == QwtDate::Hour )
+        {
+            daylightSaving = stepSize > 1;
+        }
+    }
+
+    return daylightSaving;
+}
+
+static inline int qwtSecondsMajor(
+    double stepSize, QwtDate::IntervalType intervalType )
+{
+    const double s = qwtMsecsForType( intervalType ) / 1000;
+    return static_cast<int>( stepSize * s );
+}
+
+static QwtScaleDiv qwtDivideToMSecs(
+    const QDateTime &minDate, const QDateTime &maxDate,
+    int secondsMajor, double secondsMinor )
+{
+    // Without daylight saving corrections all interval types up to
+    // weeks have a fixed length. So we can calculate the ticks
+    // in integer epoch milliseconds without any QDateTime operations
+
+    QList<double> majorTicks;
+    QList<double> mediumTicks;
+    QList<double> minorTicks;
+
+    const qint64 msecsMajor = qint64( secondsMajor ) * 1000;
+
+    int numMinorSteps = 0;
+    if ( secondsMinor > 0.0 )
+        numMinorSteps = qFloor( secondsMajor / secondsMinor );
+
+    // offsets of the minor ticks from their major tick
+
+    QVector<qint64> minorOffsets( qMax( numMinorSteps, 1 ) );
+    for ( int i = 1; i < numMinorSteps; i++ )
+        minorOffsets[i] = qRound64( i * secondsMinor * 1000 );
+
+    const qint64 t1 = static_cast<qint64>( QwtDate::toDouble( minDate ) );
+    const qint64 t2 = static_cast<qint64>( QwtDate::toDouble( maxDate ) );
+
+    for ( qint64 t = t1; msecsMajor > 0 && t <= t2; t += msecsMajor )
+    {
+        majorTicks += double( t );
+
+        for ( int i = 1; i < numMinorSteps; i++ )
+        {
+            const double minorValue = double( t + minorOffsets[i] );
+
+            const bool isMedium = ( numMinorSteps % 2 == 0 )
+                && ( i != 1 ) && ( i == numMinorSteps / 2 );
+
+            if ( isMedium )
+                mediumTicks += minorValue;
+            else
+                minorTicks += minorValue;
+        }
+    }
+
+    QwtScaleDiv scaleDiv;
+
+    scaleDiv.setInterval( double( t1 ), double( t2 ) );
+
+    scaleDiv.setTicks( QwtScaleDiv::MajorTick, majorTicks );
+    scaleDiv.setTicks( QwtScaleDiv::MediumTick, mediumTicks );
+    scaleDiv.setTicks( QwtScaleDiv::MinorTick, minorTicks );
+
+    return scaleDiv;
+}
+
 static QwtScaleDiv qwtDivideToSeconds( 
     const QDateTime &minDate, const QDateTime &maxDate,
     double stepSize, int maxMinSteps,
@@ -458,19 +540,18 @@ static QwtScaleDiv qwtDivideToSeconds(
             maxMinSteps, intervalType );
     }
 
-    bool daylightSaving = false;
-    if ( minDate.timeSpec() == Qt::LocalTime )
-    {
-        daylightSaving = intervalType > QwtDate::Hour;
-        if ( intervalType == QwtDate::Hour )
-        {
-            daylightSaving = stepSize > 1;
-        }
-    }
+    const bool daylightSaving =
+        qwtHasDaylightSaving( minDate, stepSize, intervalType );
 
     const double s = qwtMsecsForType( intervalType ) / 1000;
-    const int secondsMajor = static_cast<int>( stepSize * s );
+    const int secondsMajor = qwtSecondsMajor( stepSize, intervalType );
     const double secondsMinor = minStepSize * s;
+
+    if ( !daylightSaving )
+    {
+        return qwtDivideToMSecs( minDate, maxDate,
+            secondsMajor, secondsMinor );
+    }
     
     // UTC excludes daylight savings. So from the difference
     // of a date and its UTC counterpart we can find out
@@ -714,6 +795,72 @@ static QwtScaleDiv qwtDivideToYears(
     return scaleDiv;
 }
 
+static bool qwtIsShiftInvariant( const QDateTime &dt0,
+    double stepSize, QwtDate::IntervalType intervalType )
+{
+    /*
+      The ticks are generated by adding steps to the first major tick.
+      When each major tick of such a sequence would lead to the
+      same ticks, as when starting from the first one, a division
+      can be reused for any interval, that starts at one of its
+      major ticks.
+     */
+
+    if ( intervalType <= QwtDate::Week )
+        return !qwtHasDaylightSaving( dt0, stepSize, intervalType );
+
+    if ( intervalType == QwtDate::Year )
+    {
+        // there is no year 0 in the Julian calendar
+        return dt0.date().year() > 1;
+    }
+
+    return true;
+}
+
+static QDateTime qwtAddSteps( const QDateTime &dt,
+    double stepSize, QwtDate::IntervalType intervalType, int numSteps )
+{
+    if ( intervalType <= QwtDate::Week )
+    {
+        const qint64 seconds = qwtSecondsMajor( stepSize, intervalType );
+        return dt.addSecs( numSteps * seconds );
+    }
+
+    if ( intervalType == QwtDate::Month )
+        return dt.addMonths( numSteps * static_cast<int>( stepSize ) );
+
+    return dt.addYears( numSteps * static_cast<int>( stepSize ) );
+}
+
+static QwtScaleDiv qwtDivideInterval(
+    QDateTime minDate, const QDateTime &maxDate,
+    double stepSize, int maxMinSteps, QwtDate::IntervalType intervalType )
+{
+    QwtScaleDiv scaleDiv;
+
+    if ( intervalType <= QwtDate::Week )
+    {
+        scaleDiv = qwtDivideToSeconds( minDate, maxDate,
+            stepSize, maxMinSteps, intervalType );
+    }
+    else
+    {
+        if( intervalType == QwtDate::Month )
+        {
+            scaleDiv = qwtDivideToMonths( minDate, maxDate,
+                stepSize, maxMinSteps );
+        }
+        else if ( intervalType == QwtDate::Year )
+        {
+            scaleDiv = qwtDivideToYears( minDate, maxDate,
+                stepSize, maxMinSteps );
+        }
+    }
+
+    return scaleDiv;
+}
+
 class QwtDateScaleEngine::PrivateData
 {
 public:
@@ -725,10 +872,40 @@ public:
     {
     }
 
+    /*
+      The last division, that has been calculated for an
+      extended interval. As long as the step size doesn't
+      change - f.e. when panning - the ticks are taken from
+      this division.
+     */
+    class TickCache
+    {
+    public:
+        TickCache():
+            isValid( false )
+        {
+        }
+
+        bool isValid;
+
+        QwtDate::IntervalType intervalType;
+        double stepSize;
+        int maxMinorSteps;
+        bool isShiftInvariant;
+
+        QVector<double> majorTicks;
+        double maxValue;
+
+        QwtScaleDiv scaleDiv;
+    };
+
     Qt::TimeSpec timeSpec;
     int utcOffset;
     QwtDate::Week0Type week0Type;
     int maxWeeks;
+
+    QMutex mutex;
+    TickCache tickCache;
 };      
 
 
@@ -765,6 +942,7 @@ QwtDateScaleEngine::~QwtDateScaleEngine()
 void QwtDateScaleEngine::setTimeSpec( Qt::TimeSpec timeSpec )
 {
     d_data->timeSpec = timeSpec;
+    invalidateCache();
 }
 
 /*!
@@ -789,6 +967,7 @@ Qt::TimeSpec QwtDateScaleEngine::timeSpec() const
 void QwtDateScaleEngine::setUtcOffset( int seconds )
 {
     d_data->utcOffset = seconds;
+    invalidateCache();
 }
 
 /*!
@@ -815,6 +994,7 @@ int QwtDateScaleEngine::utcOffset() const
 void QwtDateScaleEngine::setWeek0Type( QwtDate::Week0Type week0Type )
 {
     d_data->week0Type = week0Type;
+    invalidateCache();
 }
 
 /*!
@@ -988,6 +1168,10 @@ void QwtDateScaleEngine::autoScale( int maxNumSteps,
    \param stepSize Step size. If stepSize == 0, the scaleEngine
                    calculates one.
    \return Calculated scale division
+
+   \note The ticks are taken from the previous division, when
+         it covers the interval and has the same step size.
+   \sa invalidateCache()
 */
 QwtScaleDiv QwtDateScaleEngine::divideScale( double x1, double x2,
     int maxMajorSteps, int maxMinorSteps, double stepSize ) const
@@ -1064,31 +1248,106 @@ QwtScaleDiv QwtDateScaleEngine::buildScaleDiv(
         dt0 = alignDate( minDate, stepSize, intervalType, true );
     }
 
-    QwtScaleDiv scaleDiv;
+    const double value0 = QwtDate::toDouble( dt0 );
+    const double maxValue = QwtDate::toDouble( maxDate );
 
-    if ( intervalType <= QwtDate::Week )
-    {
-        scaleDiv = qwtDivideToSeconds( dt0, maxDate, 
-            stepSize, maxMinorSteps, intervalType );
-    }
-    else
+    QMutexLocker locker( &d_data->mutex );
+
+    PrivateData::TickCache &cache = d_data->tickCache;
+
+    if ( cache.isValid && cache.intervalType == intervalType
+        && cache.stepSize == stepSize && cache.maxMinorSteps == maxMinorSteps
+        && maxValue <= cache.maxValue && !cache.majorTicks.isEmpty() )
     {
-        if( intervalType == QwtDate::Month )
+        bool isCached = ( value0 == cache.majorTicks.first() );
+        if ( !isCached && cache.isShiftInvariant )
         {
-            scaleDiv = qwtDivideToMonths( dt0, maxDate,
-                stepSize, maxMinorSteps );
+            isCached = qBinaryFind( cache.majorTicks, value0 )
+                != cache.majorTicks.constEnd();
         }
-        else if ( intervalType == QwtDate::Year )
+
+        if ( isCached )
         {
-            scaleDiv = qwtDivideToYears( dt0, maxDate,
-                stepSize, maxMinorSteps );
+            // the caller bounds the division to the requested interval
+            return cache.scaleDiv;
         }
     }
 
+    /*
+      To be able to reuse the division for the following intervals,
+      that are usually shifted by panning, we divide an
+      interval, that is extended by the width of the requested
+      interval in both directions. Extending at the beginning is
+      only possible when the ticks are shift invariant.
+     */
+
+    const int numSteps = qMax( maxMajorSteps, 1 );
+
+    QDateTime dtFrom = dt0;
+
+    const bool isShiftInvariant =
+        qwtIsShiftInvariant( dt0, stepSize, intervalType );
+
+    if ( isShiftInvariant )
+    {
+        const QDateTime dt = qwtAddSteps(
+            dt0, stepSize, intervalType, -numSteps );
+
+        if ( dt.isValid() && dt < dt0 &&
+            qwtIsShiftInvariant( dt, stepSize, intervalType ) )
+        {
+            dtFrom = dt;
+        }
+    }
+
+    QDateTime dtTo = qwtAddSteps( maxDate, stepSize, intervalType, numSteps );
+    if ( !dtTo.isValid() || dtTo < maxDate )
+        dtTo = maxDate;
+
+    QwtScaleDiv scaleDiv = qwtDivideInterval(
+        dtFrom, dtTo, stepSize, maxMinorSteps, intervalType );
+
+    cache.majorTicks = scaleDiv.ticks( QwtScaleDiv::MajorTick ).toVector();
+
+    if ( qBinaryFind( cache.majorTicks, value0 ) == cache.majorTicks.constEnd() )
+    {
+        // should never happen: alignDate() might have been
+        // overloaded with alignments, that are not in the
+        // sequence of steps.
+
+        cache.isValid = false;
+
+        return qwtDivideInterval( dt0, maxDate,
+            stepSize, maxMinorSteps, intervalType );
+    }
+
+    cache.isValid = true;
+    cache.intervalType = intervalType;
+    cache.stepSize = stepSize;
+    cache.maxMinorSteps = maxMinorSteps;
+    cache.isShiftInvariant = isShiftInvariant;
+    cache.maxValue = QwtDate::toDouble( dtTo );
+    cache.scaleDiv = scaleDiv;
 
     return scaleDiv;
 }
 
+/*!
+  \brief Invalidate the cache of scale divisions
+
+  divideScale() keeps the last division and reuses its ticks
+  as long as intervals with the same step size are requested.
+  A derived class needs to call invalidateCache(), when changing
+  parameters, that have an effect on alignDate().
+
+  \sa divideScale(), alignDate()
+ */
+void QwtDateScaleEngine::invalidateCache()
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->tickCache = PrivateData::TickCache();
+}
+
 /*!
   Align a date/time value for a step size
 
@@ -69,6 +69,8 @@ public:
 
     QDateTime toDateTime( double ) const;
 
+    void invalidateCache();
+
 protected:
     virtual QDateTime alignDate( const QDateTime &, double stepSize,
         QwtDate::IntervalType, bool up ) const;
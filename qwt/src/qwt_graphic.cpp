@@ -16,6 +16,7 @@
 #include <qpixmap.h>
 #include <qpainterpath.h>
 #include <qmath.h>
+#include <qlist.h>
 
 static bool qwtHasScalablePen( const QPainter *painter )
 {
@@ -200,6 +201,340 @@ static inline void qwtExecCommand(
 
 }
 
+static inline bool qwtHasClipping(
+    const QwtPainterCommand::StateData *data )
+{
+    return data->flags & ( QPaintEngine::DirtyClipEnabled
+        | QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath );
+}
+
+/*
+  Remove all attributes from a state command, that are set to
+  values, that have been set before. As clip operations might
+  be combined they are never removed.
+ */
+static void qwtRemoveRedundantState( QwtPainterCommand::StateData *data,
+    QwtPainterCommand::StateData &known )
+{
+    if ( data->flags & QPaintEngine::DirtyPen )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyPen )
+            && known.pen == data->pen )
+        {
+            data->flags &= ~QPaintEngine::DirtyPen;
+        }
+        else
+        {
+            known.pen = data->pen;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyBrush )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyBrush )
+            && known.brush == data->brush )
+        {
+            data->flags &= ~QPaintEngine::DirtyBrush;
+        }
+        else
+        {
+            known.brush = data->brush;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyBrushOrigin )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyBrushOrigin )
+            && known.brushOrigin == data->brushOrigin )
+        {
+            data->flags &= ~QPaintEngine::DirtyBrushOrigin;
+        }
+        else
+        {
+            known.brushOrigin = data->brushOrigin;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyFont )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyFont )
+            && known.font == data->font )
+        {
+            data->flags &= ~QPaintEngine::DirtyFont;
+        }
+        else
+        {
+            known.font = data->font;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyBackground )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyBackground )
+            && known.backgroundMode == data->backgroundMode
+            && known.backgroundBrush == data->backgroundBrush )
+        {
+            data->flags &= ~QPaintEngine::DirtyBackground;
+        }
+        else
+        {
+            known.backgroundMode = data->backgroundMode;
+            known.backgroundBrush = data->backgroundBrush;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyTransform )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyTransform )
+            && known.transform == data->transform )
+        {
+            data->flags &= ~QPaintEngine::DirtyTransform;
+        }
+        else
+        {
+            known.transform = data->transform;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyHints )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyHints )
+            && known.renderHints == data->renderHints )
+        {
+            data->flags &= ~QPaintEngine::DirtyHints;
+        }
+        else
+        {
+            known.renderHints = data->renderHints;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyCompositionMode )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyCompositionMode )
+            && known.compositionMode == data->compositionMode )
+        {
+            data->flags &= ~QPaintEngine::DirtyCompositionMode;
+        }
+        else
+        {
+            known.compositionMode = data->compositionMode;
+        }
+    }
+
+    if ( data->flags & QPaintEngine::DirtyOpacity )
+    {
+        if ( ( known.flags & QPaintEngine::DirtyOpacity )
+            && known.opacity == data->opacity )
+        {
+            data->flags &= ~QPaintEngine::DirtyOpacity;
+        }
+        else
+        {
+            known.opacity = data->opacity;
+        }
+    }
+
+    known.flags |= data->flags;
+}
+
+/*
+  Merge the attributes of a state command into the attributes
+  of a previous one. Clip operations are not supported.
+ */
+static void qwtMergeState( QwtPainterCommand::StateData *to,
+    const QwtPainterCommand::StateData &from )
+{
+    if ( from.flags & QPaintEngine::DirtyPen )
+        to->pen = from.pen;
+
+    if ( from.flags & QPaintEngine::DirtyBrush )
+        to->brush = from.brush;
+
+    if ( from.flags & QPaintEngine::DirtyBrushOrigin )
+        to->brushOrigin = from.brushOrigin;
+
+    if ( from.flags & QPaintEngine::DirtyFont )
+        to->font = from.font;
+
+    if ( from.flags & QPaintEngine::DirtyBackground )
+    {
+        to->backgroundMode = from.backgroundMode;
+        to->backgroundBrush = from.backgroundBrush;
+    }
+
+    if ( from.flags & QPaintEngine::DirtyTransform )
+        to->transform = from.transform;
+
+    if ( from.flags & QPaintEngine::DirtyHints )
+        to->renderHints = from.renderHints;
+
+    if ( from.flags & QPaintEngine::DirtyCompositionMode )
+        to->compositionMode = from.compositionMode;
+
+    if ( from.flags & QPaintEngine::DirtyOpacity )
+        to->opacity = from.opacity;
+
+    to->flags |= from.flags;
+}
+
+/*
+  The area of a path, that might be affected when painting it,
+  in the coordinates of the recording device. An invalid rectangle
+  is returned, when the pen is unknown.
+ */
+static QRectF qwtPathPaintRect( const QPainterPath &path,
+    const QwtPainterCommand::StateData &known )
+{
+    if ( !( known.flags & QPaintEngine::DirtyPen ) )
+        return QRectF();
+
+    QTransform transform;
+    if ( known.flags & QPaintEngine::DirtyTransform )
+        transform = known.transform;
+
+    const QPen &pen = known.pen;
+
+    double pw = 0.0;
+    if ( pen.style() != Qt::NoPen )
+    {
+        pw = qMax( pen.widthF(), qreal( 1.0 ) );
+        if ( pen.joinStyle() == Qt::MiterJoin
+            || pen.joinStyle() == Qt::SvgMiterJoin )
+        {
+            pw *= qMax( pen.miterLimit(), qreal( 1.0 ) );
+        }
+    }
+
+    // as the pen might be cosmetic or not, we add the width
+    // in path and device coordinates + 1 pixel for antialiasing
+
+    QRectF rect = path.controlPointRect();
+    rect.adjust( -pw, -pw, pw, pw );
+
+    rect = transform.mapRect( rect );
+    rect.adjust( -pw - 1.0, -pw - 1.0, pw + 1.0, pw + 1.0 );
+
+    return rect;
+}
+
+static inline bool qwtCanCacheRaster( const QPainter *painter )
+{
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::Raster:
+        case QPaintEngine::X11:
+        case QPaintEngine::OpenGL:
+        case QPaintEngine::OpenGL2:
+            break;
+
+        default:
+            return false;
+    }
+
+#if QT_VERSION >= 0x050000
+    if ( painter->device()->devicePixelRatio() != 1 )
+        return false;
+#endif
+
+    return painter->transform().type() <= QTransform::TxScale;
+}
+
+static inline double qwtSubPixel( double value, int &pos )
+{
+    // the subpixel position in steps of 1/8 pixel
+
+    pos = qFloor( value );
+
+    double off = qRound( ( value - pos ) * 8.0 ) / 8.0;
+    if ( off >= 1.0 )
+    {
+        pos++;
+        off = 0.0;
+    }
+
+    return off;
+}
+
+/*
+  Images of a graphic, rendered for different scaling factors
+  and subpixel positions. The cache is not shared between copies
+  of a graphic.
+ */
+class QwtGraphicRasterCache
+{
+public:
+    class Entry
+    {
+    public:
+        bool operator==( const Entry &other ) const
+        {
+            return ( sx == other.sx ) && ( sy == other.sy )
+                && ( dx == other.dx ) && ( dy == other.dy )
+                && ( initialTransform == other.initialTransform )
+                && ( renderHints == other.renderHints );
+        }
+
+        double sx, sy;
+        double dx, dy;
+        QTransform initialTransform;
+        int renderHints;
+
+        QPoint offset;
+        QImage image;
+    };
+
+    enum
+    {
+        MaxEntries = 8,
+        MaxPixels = 512 * 512
+    };
+
+    QwtGraphicRasterCache()
+    {
+    }
+
+    QwtGraphicRasterCache( const QwtGraphicRasterCache & )
+    {
+    }
+
+    QwtGraphicRasterCache &operator=( const QwtGraphicRasterCache & )
+    {
+        clear();
+        return *this;
+    }
+
+    bool find( Entry &entry ) const
+    {
+        for ( int i = 0; i < d_entries.size(); i++ )
+        {
+            if ( d_entries[i] == entry )
+            {
+                entry = d_entries[i];
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void insert( const Entry &entry )
+    {
+        if ( d_entries.size() >= MaxEntries )
+            d_entries.removeLast();
+
+        d_entries.prepend( entry );
+    }
+
+    void clear()
+    {
+        d_entries.clear();
+    }
+
+private:
+    QList<Entry> d_entries;
+};
+
 class QwtGraphic::PathInfo
 {
 public:
@@ -320,7 +655,9 @@ public:
     PrivateData():
         boundingRect( 0.0, 0.0, -1.0, -1.0 ),
         pointRect( 0.0, 0.0, -1.0, -1.0 ),
-        initialTransform( NULL )
+        initialTransform( NULL ),
+        scaleX( 1.0 ),
+        scaleY( 1.0 )
     {
     }
 
@@ -333,6 +670,13 @@ public:
 
     QwtGraphic::RenderHints renderHints;
     QTransform *initialTransform;
+
+    // scaling factors of the last render( QPainter *, QRectF ... )
+    QSizeF scaleSize;
+    double scaleX;
+    double scaleY;
+
+    QwtGraphicRasterCache rasterCache;
 };
 
 /*!
@@ -394,6 +738,7 @@ void QwtGraphic::reset()
     d_data->pointRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
     d_data->defaultSize = QSizeF();
 
+    invalidateCaches();
 }
 
 /*!
@@ -428,6 +773,8 @@ void QwtGraphic::setRenderHint( RenderHint hint, bool on )
         d_data->renderHints |= hint;
     else
         d_data->renderHints &= ~hint;
+
+    invalidateCaches();
 }
 
 /*!
@@ -565,6 +912,13 @@ void QwtGraphic::render( QPainter *painter ) const
     if ( isNull() )
         return;
 
+    if ( d_data->renderHints.testFlag( RenderRasterCached )
+        && qwtCanCacheRaster( painter ) )
+    {
+        if ( renderRaster( painter ) )
+            return;
+    }
+
     const int numCommands = d_data->commands.size();
     const QwtPainterCommand *commands = d_data->commands.constData();
 
@@ -625,21 +979,34 @@ void QwtGraphic::render( QPainter *painter, const QRectF &rect,
     const bool scalePens = 
         !d_data->renderHints.testFlag( RenderPensUnscaled );
 
-    for ( int i = 0; i < d_data->pathInfos.size(); i++ )
+    if ( rect.size() == d_data->scaleSize )
     {
-        const PathInfo info = d_data->pathInfos[i];
+        // the scaling factors only depend on the size
+        sx = d_data->scaleX;
+        sy = d_data->scaleY;
+    }
+    else
+    {
+        for ( int i = 0; i < d_data->pathInfos.size(); i++ )
+        {
+            const PathInfo info = d_data->pathInfos[i];
 
-        const double ssx = info.scaleFactorX( 
-            d_data->pointRect, rect, scalePens );
+            const double ssx = info.scaleFactorX(
+                d_data->pointRect, rect, scalePens );
 
-        if ( ssx > 0.0 )
-            sx = qMin( sx, ssx );
+            if ( ssx > 0.0 )
+                sx = qMin( sx, ssx );
 
-        const double ssy = info.scaleFactorY( 
-            d_data->pointRect, rect, scalePens );
+            const double ssy = info.scaleFactorY(
+                d_data->pointRect, rect, scalePens );
+
+            if ( ssy > 0.0 )
+                sy = qMin( sy, ssy );
+        }
 
-        if ( ssy > 0.0 )
-            sy = qMin( sy, ssy );
+        d_data->scaleSize = rect.size();
+        d_data->scaleX = sx;
+        d_data->scaleY = sy;
     }
 
     if ( aspectRatioMode == Qt::KeepAspectRatio )
@@ -865,6 +1232,7 @@ void QwtGraphic::drawPath( const QPainterPath &path )
         return;
 
     d_data->commands += QwtPainterCommand( path );
+    invalidateCaches();
 
     if ( !path.isEmpty() )
     {
@@ -904,6 +1272,7 @@ void QwtGraphic::drawPixmap( const QRectF &rect,
         return;
 
     d_data->commands += QwtPainterCommand( rect, pixmap, subRect );
+    invalidateCaches();
 
     const QRectF r = painter->transform().mapRect( rect );
     updateControlPointRect( r );
@@ -928,6 +1297,7 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
         return;
 
     d_data->commands += QwtPainterCommand( rect, image, subRect, flags );
+    invalidateCaches();
 
     const QRectF r = painter->transform().mapRect( rect );
 
@@ -944,6 +1314,90 @@ void QwtGraphic::drawImage( const QRectF &rect, const QImage &image,
 void QwtGraphic::updateState( const QPaintEngineState &state)
 {
     d_data->commands += QwtPainterCommand( state );
+    invalidateCaches();
+}
+
+/*!
+  \brief Render the graphic from the raster cache
+
+  \param painter Painter with a transformation without rotation
+  \return false, when the graphic is too large for being cached
+
+  \sa RenderRasterCached
+ */
+bool QwtGraphic::renderRaster( QPainter *painter ) const
+{
+    const QTransform transform = painter->transform();
+
+    QwtGraphicRasterCache::Entry entry;
+    entry.sx = transform.m11();
+    entry.sy = transform.m22();
+    entry.renderHints = painter->renderHints();
+
+    if ( d_data->initialTransform )
+        entry.initialTransform = *d_data->initialTransform;
+
+    int x, y;
+    entry.dx = qwtSubPixel( transform.dx(), x );
+    entry.dy = qwtSubPixel( transform.dy(), y );
+
+    if ( !d_data->rasterCache.find( entry ) )
+    {
+        QRectF br = scaledBoundingRect( entry.sx, entry.sy );
+        br.translate( entry.dx, entry.dy );
+        br.adjust( -2.0, -2.0, 2.0, 2.0 );
+
+        const QRect imageRect = br.toAlignedRect();
+        if ( imageRect.isEmpty() ||
+            imageRect.width() * imageRect.height() >
+                QwtGraphicRasterCache::MaxPixels )
+        {
+            return false;
+        }
+
+        QImage image( imageRect.size(), QImage::Format_ARGB32_Premultiplied );
+        image.fill( 0u );
+
+        const QTransform imageTransform( entry.sx, 0.0, 0.0, entry.sy,
+            entry.dx - imageRect.x(), entry.dy - imageRect.y() );
+
+        QPainter imagePainter( &image );
+        imagePainter.setRenderHints( painter->renderHints() );
+        imagePainter.setPen( painter->pen() );
+        imagePainter.setBrush( painter->brush() );
+        imagePainter.setFont( painter->font() );
+        imagePainter.setTransform( imageTransform );
+
+        const int numCommands = d_data->commands.size();
+        const QwtPainterCommand *commands = d_data->commands.constData();
+
+        for ( int i = 0; i < numCommands; i++ )
+        {
+            qwtExecCommand( &imagePainter, commands[i],
+                d_data->renderHints, imageTransform,
+                d_data->initialTransform );
+        }
+
+        imagePainter.end();
+
+        entry.offset = imageRect.topLeft();
+        entry.image = image;
+
+        d_data->rasterCache.insert( entry );
+    }
+
+    painter->save();
+    painter->resetTransform();
+    painter->drawImage( QPoint( x, y ) + entry.offset, entry.image );
+    painter->restore();
+
+    return true;
+}
+
+void QwtGraphic::invalidateCaches()
+{
+    d_data->scaleSize = QSizeF();
+    d_data->rasterCache.clear();
 }
 
 void QwtGraphic::updateBoundingRect( const QRectF &rect )
@@ -1007,3 +1461,125 @@ void QwtGraphic::setCommands( QVector< QwtPainterCommand > &commands )
 
     painter.end();
 }
+
+/*!
+  \brief Optimize the list of paint commands for replaying
+
+  - state changes to values, that have been set before, are removed
+  - consecutive state changes are merged
+  - state changes at the end of the list are removed
+  - consecutive paths with the same state are merged, when their
+    bounding rectangles don't intersect
+
+  The rendered graphic is the same, beside the situation of
+  rendering the graphic downscaled with unscaled or cosmetic pens,
+  where the outlines of merged paths might overlap in a different order.
+
+  \sa commands(), render()
+ */
+void QwtGraphic::optimize()
+{
+    const int numCommands = d_data->commands.size();
+    if ( numCommands <= 1 )
+        return;
+
+    const QwtPainterCommand *commands = d_data->commands.constData();
+
+    QVector<QwtPainterCommand> optimized;
+    optimized.reserve( numCommands );
+
+    QwtPainterCommand::StateData known;
+    known.flags = 0;
+
+    int stateIndex = -1; // last state command without a path after it
+    int pathIndex = -1; // last path command without a state after it
+
+    QVector<QRectF> pathRects; // paint rectangles of the merged paths
+
+    for ( int i = 0; i < numCommands; i++ )
+    {
+        const QwtPainterCommand &cmd = commands[i];
+
+        switch( cmd.type() )
+        {
+            case QwtPainterCommand::State:
+            {
+                QwtPainterCommand stateCmd = cmd;
+
+                QwtPainterCommand::StateData *data = stateCmd.stateData();
+                qwtRemoveRedundantState( data, known );
+
+                if ( data->flags == 0 )
+                    break;
+
+                if ( stateIndex >= 0 )
+                {
+                    QwtPainterCommand::StateData *pendingData =
+                        optimized[stateIndex].stateData();
+
+                    if ( !qwtHasClipping( pendingData )
+                        && !qwtHasClipping( data ) )
+                    {
+                        qwtMergeState( pendingData, *data );
+                        break;
+                    }
+                }
+
+                optimized += stateCmd;
+
+                stateIndex = optimized.size() - 1;
+                pathIndex = -1;
+
+                break;
+            }
+            case QwtPainterCommand::Path:
+            {
+                const QRectF rect = qwtPathPaintRect( *cmd.path(), known );
+
+                bool doMerge = ( pathIndex >= 0 ) && rect.isValid()
+                    && ( pathRects.size() < 100 )
+                    && cmd.path()->fillRule() ==
+                        optimized[pathIndex].path()->fillRule();
+
+                for ( int j = 0; doMerge && j < pathRects.size(); j++ )
+                {
+                    if ( pathRects[j].intersects( rect ) )
+                        doMerge = false;
+                }
+
+                if ( doMerge )
+                {
+                    optimized[pathIndex].path()->addPath( *cmd.path() );
+                }
+                else
+                {
+                    optimized += cmd;
+
+                    pathIndex = optimized.size() - 1;
+                    pathRects.clear();
+                }
+
+                pathRects += rect;
+                stateIndex = -1;
+
+                break;
+            }
+            default:
+            {
+                optimized += cmd;
+
+                stateIndex = -1;
+                pathIndex = -1;
+            }
+        }
+    }
+
+    while ( !optimized.isEmpty() &&
+        optimized.last().type() == QwtPainterCommand::State )
+    {
+        optimized.removeLast();
+    }
+
+    d_data->commands = optimized;
+    invalidateCaches();
+}
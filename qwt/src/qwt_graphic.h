@@ -69,6 +69,11 @@ class QwtPainterCommand;
     scaling with a fixed aspect ratio always needs to be calculated from the 
     control point rectangle.
 
+    \note QwtGraphic is not thread-safe. Even the const render() methods
+          modify internal state and caches, so a graphic must not be
+          rendered from different threads at the same time. Copies of
+          a graphic can be used in different threads.
+
     \sa QwtPainterCommand
  */
 class QWT_EXPORT QwtGraphic: public QwtNullPaintDevice
@@ -92,7 +97,24 @@ public:
 
            \sa render();
          */
-        RenderPensUnscaled = 0x1
+        RenderPensUnscaled = 0x1,
+
+        /*!
+           The graphic is rendered into an image, that is cached for
+           the scaling factors and the subpixel position of the painter
+           transformation. Rendering the graphic again with the same
+           scaling factors is a blit of the cached image.
+
+           The raster cache is used for raster devices and painter
+           transformations without rotation only. It is intended for
+           graphics, that are rendered many times at the same size
+           - like symbols or legend icons - and that set up their pens
+           and brushes themselves.
+
+           \note The graphic might be shifted up to 1/16 of a pixel.
+           \sa render()
+         */
+        RenderRasterCached = 0x2
     };
 
     /*! 
@@ -141,6 +163,8 @@ public:
     const QVector< QwtPainterCommand > &commands() const;
     void setCommands( QVector< QwtPainterCommand > & );
 
+    void optimize();
+
     void setDefaultSize( const QSizeF & );
     QSizeF defaultSize() const;
     
@@ -161,6 +185,9 @@ protected:
     virtual void updateState( const QPaintEngineState &state );
 
 private:
+    bool renderRaster( QPainter * ) const;
+
+    void invalidateCaches();
     void updateBoundingRect( const QRectF & );
     void updateControlPointRect( const QRectF & );
 
@@ -19,11 +19,15 @@
 #include <qpainter.h>
 #include <qstyle.h>
 #include <qstyleoption.h>
+#include <qhash.h>
 
 class QwtLegendMap
 {
 public:
-    inline bool isEmpty() const { return d_entries.isEmpty(); }
+    inline bool isEmpty() const
+    {
+        return d_itemMap.isEmpty() && d_entries.isEmpty();
+    }
 
     void insert( const QVariant &, const QList<QWidget *> & );
     void remove( const QVariant & );
@@ -34,10 +38,19 @@ public:
     QVariant itemInfo( const QWidget * ) const;
 
 private:
-    // we don't know anything about itemInfo and therefore don't have
-    // any key that can be used for a map or hashtab.
-    // But a simple linear list is o.k. here, as we will never have
-    // more than a few entries.
+    static inline const QwtPlotItem *plotItem( const QVariant &itemInfo )
+    {
+        if ( itemInfo.canConvert<QwtPlotItem *>() )
+            return qvariant_cast<QwtPlotItem *>( itemInfo );
+
+        return NULL;
+    }
+
+    void removeWidgets( const QList<QWidget *> & );
+
+    // The itemInfo of QwtPlot is a QwtPlotItem pointer, that
+    // can be used as key of a hash table. For other types of itemInfo
+    // we don't have a key and fall back to a linear list.
 
     class Entry
     {
@@ -46,36 +59,70 @@ private:
         QList<QWidget *> widgets;
     };
 
+    QHash< const QwtPlotItem *, Entry > d_itemMap;
     QList< Entry > d_entries;
+
+    QHash< const QWidget *, QVariant > d_widgetMap;
 };
 
 void QwtLegendMap::insert( const QVariant &itemInfo, 
     const QList<QWidget *> &widgets )
 {
-    for ( int i = 0; i < d_entries.size(); i++ )
+    Entry *entry = NULL;
+
+    const QwtPlotItem *item = plotItem( itemInfo );
+    if ( item )
     {
-        Entry &entry = d_entries[i];
-        if ( entry.itemInfo == itemInfo )
+        entry = &d_itemMap[ item ];
+    }
+    else
+    {
+        for ( int i = 0; i < d_entries.size(); i++ )
         {
-            entry.widgets = widgets;
-            return;
+            if ( d_entries[i].itemInfo == itemInfo )
+            {
+                entry = &d_entries[i];
+                break;
+            }
+        }
+
+        if ( entry == NULL )
+        {
+            d_entries += Entry();
+            entry = &d_entries.last();
         }
     }
 
-    Entry newEntry;
-    newEntry.itemInfo = itemInfo;
-    newEntry.widgets = widgets;
+    removeWidgets( entry->widgets );
+
+    entry->itemInfo = itemInfo;
+    entry->widgets = widgets;
 
-    d_entries += newEntry;
+    for ( int i = 0; i < widgets.size(); i++ )
+        d_widgetMap.insert( widgets[i], itemInfo );
 }
 
 void QwtLegendMap::remove( const QVariant &itemInfo )
 {
+    const QwtPlotItem *item = plotItem( itemInfo );
+    if ( item )
+    {
+        QHash< const QwtPlotItem *, Entry >::iterator it = d_itemMap.find( item );
+        if ( it != d_itemMap.end() )
+        {
+            removeWidgets( it.value().widgets );
+            d_itemMap.erase( it );
+        }
+
+        return;
+    }
+
     for ( int i = 0; i < d_entries.size(); i++ )
     {
         Entry &entry = d_entries[i];
         if ( entry.itemInfo == itemInfo )
         {
+            removeWidgets( entry.widgets );
             d_entries.removeAt( i );
             return;
         }
@@ -84,25 +131,43 @@ void QwtLegendMap::remove( const QVariant &itemInfo )
 
 void QwtLegendMap::removeWidget( const QWidget *widget )
 {
+    const QVariant itemInfo = d_widgetMap.take( widget );
+    if ( !itemInfo.isValid() )
+        return;
+
     QWidget *w = const_cast<QWidget *>( widget );
 
+    const QwtPlotItem *item = plotItem( itemInfo );
+    if ( item )
+    {
+        QHash< const QwtPlotItem *, Entry >::iterator it = d_itemMap.find( item );
+        if ( it != d_itemMap.end() )
+            it.value().widgets.removeAll( w );
+
+        return;
+    }
+
     for ( int i = 0; i < d_entries.size(); i++ )
-        d_entries[ i ].widgets.removeAll( w );
+    {
+        Entry &entry = d_entries[i];
+        if ( entry.itemInfo == itemInfo )
+        {
+            entry.widgets.removeAll( w );
+            return;
+        }
+    }
+}
+
+void QwtLegendMap::removeWidgets( const QList<QWidget *> &widgets )
+{
+    for ( int i = 0; i < widgets.size(); i++ )
+        d_widgetMap.remove( widgets[i] );
 }
 
 QVariant QwtLegendMap::itemInfo( const QWidget *widget ) const
 {
     if ( widget != NULL )
-    {
-        QWidget *w = const_cast<QWidget *>( widget );
-
-        for ( int i = 0; i < d_entries.size(); i++ )
-        {
-            const Entry &entry = d_entries[i];
-            if ( entry.widgets.indexOf( w ) >= 0 )
-                return entry.itemInfo;
-        }
-    }
+        return d_widgetMap.value( widget );
 
     return QVariant();
 }
@@ -111,6 +176,10 @@ QList<QWidget *> QwtLegendMap::legendWidgets( const QVariant &itemInfo ) const
 {
     if ( itemInfo.isValid() )
     {
+        const QwtPlotItem *item = plotItem( itemInfo );
+        if ( item )
+            return d_itemMap.value( item ).widgets;
+
         for ( int i = 0; i < d_entries.size(); i++ )
         {
             const Entry &entry = d_entries[i];
@@ -122,6 +191,22 @@ QList<QWidget *> QwtLegendMap::legendWidgets( const QVariant &itemInfo ) const
     return QList<QWidget *>();
 }
 
+static void qwtSetTabOrder( const QLayout *layout, int from )
+{
+    // set tab focus chain for the widgets starting at from
+
+    QWidget *w = NULL;
+
+    for ( int i = qMax( from, 0 ); i < layout->count(); i++ )
+    {
+        QLayoutItem *item = layout->itemAt( i );
+        if ( w && item->widget() )
+            QWidget::setTabOrder( w, item->widget() );
+
+        w = item->widget();
+    }
+}
+
 class QwtLegend::PrivateData
 {
 public:
@@ -396,6 +481,8 @@ void QwtLegend::updateLegend( const QVariant &itemInfo,
     {
         QLayout *contentsLayout = d_data->view->contentsWidget->layout();
 
+        const int numAdded = data.size() - widgetList.size();
+
         while ( widgetList.size() > data.size() )
         {
             QWidget *w = widgetList.takeLast();
@@ -438,7 +525,17 @@ void QwtLegend::updateLegend( const QVariant &itemInfo,
             d_data->itemMap.insert( itemInfo, widgetList );
         }
 
-        updateTabOrder();
+        if ( numAdded > 0 && contentsLayout )
+        {
+            // the new widgets have been appended to the layout,
+            // so we only need to extend the focus chain
+
+            qwtSetTabOrder( contentsLayout, contentsLayout->count() - numAdded - 1 );
+        }
+        else
+        {
+            updateTabOrder();
+        }
     }
     
     for ( int i = 0; i < data.size(); i++ )
@@ -498,20 +595,7 @@ void QwtLegend::updateTabOrder()
 {
     QLayout *contentsLayout = d_data->view->contentsWidget->layout();
     if ( contentsLayout )
-    {
-        // set tab focus chain
-
-        QWidget *w = NULL;
-
-        for ( int i = 0; i < contentsLayout->count(); i++ )
-        {
-            QLayoutItem *item = contentsLayout->itemAt( i );
-            if ( w && item->widget() )
-                QWidget::setTabOrder( w, item->widget() );
-
-            w = item->widget();
-        }
-    }
+        qwtSetTabOrder( contentsLayout, 0 );
 }
 
 //! Return a size hint.
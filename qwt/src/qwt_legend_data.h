@@ -60,6 +60,9 @@ public:
         // The value is an icon
         IconRole, 
 
+        // The value is a key identifying the icon
+        IconKeyRole,
+
         // Values < UserRole are reserved for internal use
         UserRole  = 32
     };
@@ -20,6 +20,7 @@
 #include <qevent.h>
 #include <qstyleoption.h>
 #include <qapplication.h>
+#include <qpixmapcache.h>
 
 static const int ButtonFrame = 2;
 static const int Margin = 2;
@@ -36,6 +37,28 @@ static QSize buttonShift( const QwtLegendLabel *w )
     return QSize( ph, pv );
 }
 
+static QPixmap qwtIconPixmap( const QwtLegendData &data,
+    const QByteArray &iconKey )
+{
+    if ( iconKey.isEmpty() )
+        return data.icon().toPixmap();
+
+    // icons with the same key are rasterized only once and
+    // shared between all labels
+
+    const QString cacheKey = QString::fromLatin1( "QwtLegendIcon:" )
+        + QString::fromLatin1( iconKey.toHex() );
+
+    QPixmap pixmap;
+    if ( !QPixmapCache::find( cacheKey, pixmap ) )
+    {
+        pixmap = data.icon().toPixmap();
+        QPixmapCache::insert( cacheKey, pixmap );
+    }
+
+    return pixmap;
+}
+
 class QwtLegendLabel::PrivateData
 {
 public:
@@ -51,6 +74,7 @@ public:
     bool isDown;
 
     QPixmap icon;
+    QByteArray iconKey;
 
     int spacing;
 };
@@ -70,7 +94,15 @@ void QwtLegendLabel::setData( const QwtLegendData &legendData )
         setUpdatesEnabled( false );
 
     setText( legendData.title() );
-    setIcon( legendData.icon().toPixmap() );
+
+    const QByteArray iconKey =
+        legendData.value( QwtLegendData::IconKeyRole ).toByteArray();
+
+    if ( iconKey.isEmpty() || iconKey != d_data->iconKey )
+    {
+        setIcon( qwtIconPixmap( legendData, iconKey ) );
+        d_data->iconKey = iconKey;
+    }
 
     if ( legendData.hasRole( QwtLegendData::ModeRole ) )
         setItemMode( legendData.mode() );
@@ -164,6 +196,7 @@ QwtLegendData::Mode QwtLegendLabel::itemMode() const
 void QwtLegendLabel::setIcon( const QPixmap &icon )
 {
     d_data->icon = icon;
+    d_data->iconKey.clear();
 
     int indent = margin() + d_data->spacing;
     if ( icon.width() > 0 )
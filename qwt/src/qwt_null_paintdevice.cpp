@@ -15,17 +15,21 @@ class QwtNullPaintDevice::PrivateData
 {
 public:
     PrivateData():
-        mode( QwtNullPaintDevice::NormalMode )
+        mode( QwtNullPaintDevice::NormalMode ),
+        engineType( QPaintEngine::User )
     {
     }
 
     QwtNullPaintDevice::Mode mode;
+    QPaintEngine::Type engineType;
 };
 
 class QwtNullPaintDevice::PaintEngine: public QPaintEngine
 {
 public:
-    PaintEngine();
+    PaintEngine( QPaintEngine::Type );
+
+    void setType( QPaintEngine::Type );
 
     virtual bool begin( QPaintDevice * );
     virtual bool end();
@@ -63,11 +67,19 @@ public:
 
 private:
     QwtNullPaintDevice *nullDevice();
+
+    QPaintEngine::Type d_type;
 };
     
-QwtNullPaintDevice::PaintEngine::PaintEngine():
-    QPaintEngine( QPaintEngine::AllFeatures )
+QwtNullPaintDevice::PaintEngine::PaintEngine( QPaintEngine::Type type ):
+    QPaintEngine( QPaintEngine::AllFeatures ),
+    d_type( type )
+{
+}
+
+void QwtNullPaintDevice::PaintEngine::setType( QPaintEngine::Type type )
 {
+    d_type = type;
 }
 
 bool QwtNullPaintDevice::PaintEngine::begin( QPaintDevice * )
@@ -84,7 +96,7 @@ bool QwtNullPaintDevice::PaintEngine::end()
 
 QPaintEngine::Type QwtNullPaintDevice::PaintEngine::type() const
 {
-    return QPaintEngine::User;
+    return d_type;
 }
 
 void QwtNullPaintDevice::PaintEngine::drawRects(
@@ -388,6 +400,36 @@ QwtNullPaintDevice::Mode QwtNullPaintDevice::mode() const
     return d_data->mode;
 }
 
+/*!
+    Set the type, that is reported by the paint engine
+
+    When QwtNullPaintDevice is a proxy for another paint device,
+    reporting the type of its paint engine lets code depending on
+    it - like QwtPainter::isAligning() - behave as if it was painting
+    to this device directly.
+
+    \param type Type of the paint engine
+    \sa engineType(), QPaintEngine::type()
+ */
+void QwtNullPaintDevice::setEngineType( QPaintEngine::Type type )
+{
+    d_data->engineType = type;
+
+    if ( d_engine )
+        d_engine->setType( type );
+}
+
+/*!
+
+eturn Type reported by the paint engine, QPaintEngine::User
+            is the default setting
+    \sa setEngineType()
+*/
+QPaintEngine::Type QwtNullPaintDevice::engineType() const
+{
+    return d_data->engineType;
+}
+
 //! See QPaintDevice::paintEngine()
 QPaintEngine *QwtNullPaintDevice::paintEngine() const
 {
@@ -396,7 +438,7 @@ QPaintEngine *QwtNullPaintDevice::paintEngine() const
         QwtNullPaintDevice *that = 
             const_cast< QwtNullPaintDevice * >( this );
 
-        that->d_engine = new PaintEngine();
+        that->d_engine = new PaintEngine( d_data->engineType );
     }
 
     return d_engine;
@@ -74,6 +74,9 @@ public:
     void setMode( Mode );
     Mode mode() const;
 
+    void setEngineType( QPaintEngine::Type );
+    QPaintEngine::Type engineType() const;
+
     virtual QPaintEngine *paintEngine() const;
 
     virtual int metric( PaintDeviceMetric metric ) const;
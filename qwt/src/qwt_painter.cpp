@@ -174,20 +174,31 @@ static inline void qwtDrawPolyline( QPainter *painter,
     }
 }
 
-static inline QSize qwtScreenResolution()
+static QImage qwtScreenImage()
 {
-    static QSize screenResolution;
-    if ( !screenResolution.isValid() )
+    int dpiX = 96;
+    int dpiY = 96;
+
+    const QDesktopWidget *desktop = QApplication::desktop();
+    if ( desktop )
     {
-        QDesktopWidget *desktop = QApplication::desktop();
-        if ( desktop )
-        {
-            screenResolution.setWidth( desktop->logicalDpiX() );
-            screenResolution.setHeight( desktop->logicalDpiY() );
-        }
+        dpiX = desktop->logicalDpiX();
+        dpiY = desktop->logicalDpiY();
     }
 
-    return screenResolution;
+    const double inchesPerMeter = 1000.0 / 25.4;
+
+    QImage image( 1, 1, QImage::Format_ARGB32_Premultiplied );
+    image.setDotsPerMeterX( qRound( dpiX * inchesPerMeter ) );
+    image.setDotsPerMeterY( qRound( dpiY * inchesPerMeter ) );
+
+    return image;
+}
+
+static inline QSize qwtScreenResolution()
+{
+    const QPaintDevice *device = QwtPainter::screenDevice();
+    return QSize( device->logicalDpiX(), device->logicalDpiY() );
 }
 
 static inline void qwtUnscaleFont( QPainter *painter )
@@ -201,13 +212,30 @@ static inline void qwtUnscaleFont( QPainter *painter )
     if ( pd->logicalDpiX() != screenResolution.width() ||
         pd->logicalDpiY() != screenResolution.height() )
     {
-        QFont pixelFont( painter->font(), QApplication::desktop() );
+        QFont pixelFont( painter->font(), QwtPainter::screenDevice() );
         pixelFont.setPixelSize( QFontInfo( pixelFont ).pixelSize() );
 
         painter->setFont( pixelFont );
     }
 }
 
+/*!
+  \brief Paint device with the logical resolution of the screen
+
+  Fonts are resolved for the screen, when calculating the layout
+  of a text. Unlike QApplication::desktop() the returned device
+  is an image, that can be used from any thread.
+
+  \return Paint device with the metrics of the screen
+  \note The screen metrics are initialized with the first call,
+         what has to be done from the GUI thread.
+*/
+QPaintDevice *QwtPainter::screenDevice()
+{
+    static QImage screenImage = qwtScreenImage();
+    return &screenImage;
+}
+
 /*!
   Check is the application is running with the X11 graphics system
   that has some special capabilities that can be used for incremental
@@ -344,6 +372,82 @@ void QwtPainter::drawRect( QPainter *painter, const QRectF &rect )
     painter->drawRect( r );
 }
 
+//! Wrapper for QPainter::drawRects()
+void QwtPainter::drawRects( QPainter *painter, 
+    const QRectF *rects, int rectCount )
+{
+    QRectF clipRect;
+    const bool deviceClipping = qwtIsClippingNeeded( painter, clipRect );
+
+    if ( deviceClipping )
+    {
+        // rectangles, that are completely inside are drawn in one batch
+
+        QVector<QRectF> innerRects;
+        innerRects.reserve( rectCount );
+
+        for ( int i = 0; i < rectCount; i++ )
+        {
+            const QRectF &r = rects[i];
+
+            if ( clipRect.contains( r ) )
+                innerRects += r;
+            else
+                drawRect( painter, r );
+        }
+
+        painter->drawRects( innerRects.constData(), innerRects.size() );
+    }
+    else
+    {
+        painter->drawRects( rects, rectCount );
+    }
+}
+
+/*!
+  \brief Append a column to a list of rectangles for drawRects()
+
+  Columns, that are not wider than a pixel, are merged with
+  the previous one, when being mapped to the same pixel column.
+  For a chart with many thin columns the number of rectangles
+  is limited by the size of the canvas then.
+
+  \param rects List of rectangles
+  \param rect Column in paint device coordinates, aligned to integers
+  \param orientation Qt::Vertical, when the columns are vertical bars
+
+  \sa drawRects()
+*/
+void QwtPainter::addColumnRect( QVector<QRectF> &rects,
+    const QRectF &rect, Qt::Orientation orientation )
+{
+    if ( !rects.isEmpty() )
+    {
+        QRectF &last = rects.last();
+
+        if ( orientation == Qt::Vertical )
+        {
+            if ( rect.width() <= 1.0 && last.width() <= 1.0
+                && qFloor( rect.left() ) == qFloor( last.left() ) )
+            {
+                last |= rect;
+                return;
+            }
+        }
+        else
+        {
+            if ( rect.height() <= 1.0 && last.height() <= 1.0
+                && qFloor( rect.top() ) == qFloor( last.top() ) )
+            {
+                last |= rect;
+                return;
+            }
+        }
+    }
+
+    rects += rect;
+}
+
 //! Wrapper for QPainter::fillRect()
 void QwtPainter::fillRect( QPainter *painter,
     const QRectF &rect, const QBrush &brush )
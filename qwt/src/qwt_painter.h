@@ -17,6 +17,7 @@
 #include <qpen.h>
 #include <qline.h>
 #include <qpalette.h>
+#include <qvector.h>
 
 class QPainter;
 class QBrush;
@@ -32,6 +33,7 @@ class QwtInterval;
 
 class QTextDocument;
 class QPainterPath;
+class QPaintDevice;
 
 /*!
   \brief A collection of QPainter workarounds
@@ -60,6 +62,9 @@ public:
 
     static void drawRect( QPainter *, double x, double y, double w, double h );
     static void drawRect( QPainter *, const QRectF &rect );
+    static void drawRects( QPainter *, const QRectF *rects, int rectCount );
+    static void addColumnRect( QVector<QRectF> &,
+        const QRectF &, Qt::Orientation );
     static void fillRect( QPainter *, const QRectF &, const QBrush & );
 
     static void drawEllipse( QPainter *, const QRectF & );
@@ -111,6 +116,8 @@ public:
     static bool isAligning( QPainter *painter );
     static bool isX11GraphicsSystem();
 
+    static QPaintDevice *screenDevice();
+
     static void fillPixmap( const QWidget *, 
         QPixmap &, const QPoint &offset = QPoint() );
 
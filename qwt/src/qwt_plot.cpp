@@ -14,14 +14,25 @@
 #include "qwt_scale_engine.h"
 #include "qwt_text_label.h"
 #include "qwt_legend.h"
+#include "qwt_virtual_legend.h"
 #include "qwt_legend_data.h"
 #include "qwt_plot_canvas.h"
+#include "qwt_system_clock.h"
 #include <qmath.h>
+#include <qmap.h>
 #include <qpainter.h>
 #include <qpointer.h>
 #include <qpaintengine.h>
 #include <qapplication.h>
 #include <qevent.h>
+#include <qimage.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
 
 static inline void qwtEnableLegendItems( QwtPlot *plot, bool on )
 {
@@ -91,6 +102,118 @@ static void qwtSetTabOrder(
     }
 }
 
+static inline QRect qwtDirtyRect( const QRectF &rect )
+{
+    // one extra pixel for antialiasing
+    return rect.toAlignedRect().adjusted( -1, -1, 1, 1 );
+}
+
+static void qwtDrawItem( QPainter *painter, const QwtPlotItem *item,
+    const QwtScaleMap *maps, const QRectF &canvasRect )
+{
+    painter->save();
+
+    painter->setRenderHint( QPainter::Antialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+    painter->setRenderHint( QPainter::HighQualityAntialiasing,
+        item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+    item->draw( painter,
+        maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+
+    painter->restore();
+}
+
+static bool qwtCanRenderConcurrently( const QPainter *painter )
+{
+    // rendering into images makes sense for raster devices only
+
+    const QPaintEngine *pe = painter->paintEngine();
+    if ( pe == NULL || pe->type() != QPaintEngine::Raster )
+        return false;
+
+    return painter->transform().type() <= QTransform::TxTranslate;
+}
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtPlotLayerCommand
+{
+public:
+    QwtPlotItemList items;
+    const QwtScaleMap *maps;
+    QRectF canvasRect;
+    QRect layerRect;
+    QRectF clipRect;
+    qreal pixelRatio;
+    QFont font;
+    bool doRecord;
+
+    QImage image;
+    QVector<double> drawTimes;
+};
+
+static void qwtRenderLayer( QwtPlotLayerCommand *command )
+{
+    const QSize size = command->layerRect.size() * command->pixelRatio;
+
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+    image.fill( 0 );
+
+#if QT_VERSION >= 0x050000
+    image.setDevicePixelRatio( command->pixelRatio );
+#endif
+
+    QPainter painter( &image );
+    painter.translate( -command->layerRect.topLeft() );
+    painter.setFont( command->font );
+
+    if ( command->clipRect.isValid() )
+        painter.setClipRect( command->clipRect );
+
+    QwtSystemClock clock;
+
+    for ( int i = 0; i < command->items.size(); i++ )
+    {
+        if ( command->doRecord )
+            clock.start();
+
+        qwtDrawItem( &painter, command->items[i], 
+            command->maps, command->canvasRect );
+
+        if ( command->doRecord )
+            command->drawTimes += clock.elapsed();
+    }
+
+    painter.end();
+
+    command->image = image;
+}
+
+template <class Legend>
+static void qwtAdjustLegendColumns( Legend *legend,
+    QwtPlot::LegendPosition pos )
+{
+    switch ( pos )
+    {
+        case QwtPlot::LeftLegend:
+        case QwtPlot::RightLegend:
+        {
+            if ( legend->maxColumns() == 0 )
+                legend->setMaxColumns( 1 ); // 1 column: align vertical
+            break;
+        }
+        case QwtPlot::TopLegend:
+        case QwtPlot::BottomLegend:
+        {
+            legend->setMaxColumns( 0 ); // unlimited
+            break;
+        }
+        default:
+            break;
+    }
+}
+
 class QwtPlot::PrivateData
 {
 public:
@@ -101,6 +224,27 @@ public:
     QwtPlotLayout *layout;
 
     bool autoReplot;
+    QwtPlot::PlotAttributes plotAttributes;
+
+    // areas of the items, when the canvas has been painted the last time
+    QMap<const QwtPlotItem *, QRectF> paintRects;
+
+    double maxReplotRate;
+    int replotTimerId;
+    QwtSystemClock replotClock;
+
+    uint numReplotRequests;
+    uint numReplotsRendered;
+    uint numReplotsDropped;
+
+    QwtPlotFrameRecord frameRecord;
+    QList<QwtPlotFrameRecord> frameRecords;
+    int maxFrameRecords;
+    uint numFrames;
+    bool recordItems;
+    bool isRecordingScale;
+
+    uint renderThreadCount;
 };
 
 /*!
@@ -145,6 +289,22 @@ void QwtPlot::initPlot( const QwtText &title )
 
     d_data->layout = new QwtPlotLayout;
     d_data->autoReplot = false;
+    d_data->plotAttributes = 0;
+
+    d_data->maxReplotRate = 0.0;
+    d_data->replotTimerId = 0;
+    d_data->numReplotRequests = 0;
+    d_data->numReplotsRendered = 0;
+    d_data->numReplotsDropped = 0;
+
+    d_data->maxFrameRecords = 100;
+    d_data->numFrames = 0;
+    d_data->recordItems = false;
+    d_data->isRecordingScale = false;
+
+    qRegisterMetaType<QwtPlotFrameRecord>( "QwtPlotFrameRecord" );
+
+    d_data->renderThreadCount = 1;
 
     // title
     d_data->titleLabel = new QwtTextLabel( this );
@@ -265,6 +425,10 @@ bool QwtPlot::event( QEvent *event )
   - QEvent::ContentsRectChange
     The layout needs to be recalculated
 
+  In RecordFrames mode the time for painting the scale widgets
+  is measured. For this the paint event is sent again, so that
+  it passes all event filters of the scale widget.
+
   \param object Object to be filtered
   \param event Event
 
@@ -274,6 +438,35 @@ bool QwtPlot::event( QEvent *event )
 */
 bool QwtPlot::eventFilter( QObject *object, QEvent *event )
 {
+    if ( ( event->type() == QEvent::Paint ) 
+        && ( d_data->plotAttributes & RecordFrames ) )
+    {
+        for ( int axisId = 0; axisId < axisCnt; axisId++ )
+        {
+            if ( object == axisWidget( axisId ) )
+            {
+                if ( d_data->isRecordingScale )
+                {
+                    // the event sent below
+                    break;
+                }
+
+                // painting the scale now, to be able to measure it
+
+                QwtSystemClock clock;
+                clock.start();
+
+                d_data->isRecordingScale = true;
+                QApplication::sendEvent( object, event );
+                d_data->isRecordingScale = false;
+
+                d_data->frameRecord.scaleTime += clock.elapsed();
+
+                return true;
+            }
+        }
+    }
+
     if ( object == d_data->canvas )
     {
         if ( event->type() == QEvent::Resize )
@@ -325,6 +518,273 @@ bool QwtPlot::autoReplot() const
     return d_data->autoReplot;
 }
 
+/*!
+  Specify an attribute of the plot
+
+  \param attribute Plot attribute
+  \param on On/Off
+  \sa testPlotAttribute()
+*/
+void QwtPlot::setPlotAttribute( PlotAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->plotAttributes |= attribute;
+    else
+        d_data->plotAttributes &= ~attribute;
+
+    if ( attribute == PartialReplot && !on )
+        d_data->paintRects.clear();
+
+    if ( attribute == RecordFrames )
+    {
+        // the painting of the scales is measured in eventFilter()
+
+        for ( int axisId = 0; axisId < axisCnt; axisId++ )
+        {
+            if ( on )
+                axisWidget( axisId )->installEventFilter( this );
+            else
+                axisWidget( axisId )->removeEventFilter( this );
+        }
+
+        d_data->frameRecord = QwtPlotFrameRecord();
+    }
+}
+
+/*!
+  \return True, when attribute is enabled
+  \sa setPlotAttribute()
+*/
+bool QwtPlot::testPlotAttribute( PlotAttribute attribute ) const
+{
+    return ( d_data->plotAttributes & attribute );
+}
+
+/*!
+  \brief Limit the number of replots per second
+
+  When a maximum rate is set replot() doesn't repaint the plot 
+  immediately, but schedules a replot for the next frame. All replot 
+  requests arriving until then are coalesced into one replot
+  - including only one updateAxes(). When the plot can't be rendered
+  at the requested rate intermediate frames are dropped.
+
+  This is useful for plots, that are updated from data, that
+  arrives at a higher rate than the display can follow.
+
+  \param rate Maximum number of replots per second. 
+              A value <= 0.0 disables the limit, what is the default setting.
+
+  \sa maxReplotRate(), replot(), getReplotStatistics()
+*/
+void QwtPlot::setMaxReplotRate( double rate )
+{
+    rate = qMax( rate, 0.0 );
+    if ( rate == d_data->maxReplotRate )
+        return;
+
+    d_data->maxReplotRate = rate;
+
+    if ( rate <= 0.0 && d_data->replotTimerId != 0 )
+    {
+        // process the pending replot
+
+        killTimer( d_data->replotTimerId );
+        d_data->replotTimerId = 0;
+
+        doReplot();
+    }
+}
+
+/*!
+  \return Maximum number of replots per second, 0.0 if unlimited
+  \sa setMaxReplotRate()
+*/
+double QwtPlot::maxReplotRate() const
+{
+    return d_data->maxReplotRate;
+}
+
+/*!
+  \brief Statistics about the replots since the last 
+         resetReplotStatistics()
+
+  \param requested Number of calls of replot()
+  \param rendered Number of replots, that have been executed
+  \param dropped Number of replots, that have been coalesced into
+                 a scheduled replot
+
+  \sa setMaxReplotRate(), resetReplotStatistics()
+*/
+void QwtPlot::getReplotStatistics( 
+    uint &requested, uint &rendered, uint &dropped ) const
+{
+    requested = d_data->numReplotRequests;
+    rendered = d_data->numReplotsRendered;
+    dropped = d_data->numReplotsDropped;
+}
+
+/*!
+  Reset the counters of the replot statistics
+  \sa getReplotStatistics()
+*/
+void QwtPlot::resetReplotStatistics()
+{
+    d_data->numReplotRequests = 0;
+    d_data->numReplotsRendered = 0;
+    d_data->numReplotsDropped = 0;
+}
+
+/*!
+  Set the maximum number of frame records, that are stored 
+  in RecordFrames mode. When the limit is exceeded the oldest
+  records are discarded.
+
+  The default setting is 100.
+
+  \param numRecords Maximum number of records
+  \sa maxFrameRecords(), frameRecords()
+*/
+void QwtPlot::setMaxFrameRecords( int numRecords )
+{
+    d_data->maxFrameRecords = qMax( numRecords, 0 );
+
+    while ( d_data->frameRecords.size() > d_data->maxFrameRecords )
+        d_data->frameRecords.removeFirst();
+}
+
+/*!
+  \return Maximum number of frame records
+  \sa setMaxFrameRecords(), frameRecords()
+*/
+int QwtPlot::maxFrameRecords() const
+{
+    return d_data->maxFrameRecords;
+}
+
+/*!
+  \return Records of the last frames, starting with the oldest one
+  \sa RecordFrames, setMaxFrameRecords(), frameRecorded()
+*/
+QList<QwtPlotFrameRecord> QwtPlot::frameRecords() const
+{
+    return d_data->frameRecords;
+}
+
+/*!
+   On multi core systems the plot items having the 
+   QwtPlotItem::ConcurrentRendering attribute can be rendered 
+   in parallel into transparent images, that are composed 
+   in z order afterwards.
+
+   Consecutive items ( in z order ) are distributed to the threads,
+   so that each thread needs one image only.
+
+   Concurrent rendering is used for raster paint devices only,
+   like the backing store of the canvas.
+
+   \note The attribute is enabled by default for the series items and
+         markers of Qwt, but not for classes derived from them. When
+         enabling it for a derived class, its reimplementations
+         of draw() ( f.e. drawSeries() ) will run in worker threads and
+         must not access widgets or state shared with other items.
+
+   \note Symbols are cached as QImage and the cache is guarded
+         by a mutex, so that the same QwtSymbol can be shared
+         between items rendered in different threads.
+
+   \param numThreads Number of threads to be used for rendering.
+                     If numThreads is set to 0, the system specific
+                     ideal thread count is used.
+
+   The default thread count is 1 ( = no additional threads )
+
+   \sa renderThreadCount(), drawItems(),
+       QwtPlotItem::setRenderThreadCount()
+*/
+void QwtPlot::setRenderThreadCount( uint numThreads )
+{
+    d_data->renderThreadCount = numThreads;
+}
+
+/*!
+   \return Number of threads to be used for rendering the items.
+   \sa setRenderThreadCount()
+*/
+uint QwtPlot::renderThreadCount() const
+{
+    return d_data->renderThreadCount;
+}
+
+/*!
+  \brief Update the plot, after a plot item has been changed
+
+  When the PartialReplot attribute is enabled and the item has no 
+  effect on the scales or the canvas margins only the areas of its
+  previous and current paint bounding rectangles are repainted.
+  Otherwise the plot is replotted if autoReplot() is \c true.
+
+  \param plotItem Plot item, that has been changed
+  \sa autoRefresh(), QwtPlotItem::paintBoundingRect()
+*/
+void QwtPlot::autoRefreshItem( QwtPlotItem *plotItem )
+{
+    if ( !d_data->autoReplot )
+        return;
+
+    if ( d_data->replotTimerId != 0 )
+    {
+        // the item will be painted by the scheduled replot
+        return;
+    }
+
+    bool doReplot = !( d_data->plotAttributes & PartialReplot ) 
+        || ( d_data->canvas == NULL )
+        || plotItem->testItemAttribute( QwtPlotItem::Margins );
+
+    if ( !doReplot && plotItem->testItemAttribute( QwtPlotItem::AutoScale ) )
+    {
+        doReplot = axisAutoScale( plotItem->xAxis() ) 
+            || axisAutoScale( plotItem->yAxis() );
+    }
+
+    if ( doReplot )
+    {
+        replot();
+        return;
+    }
+
+    const QRect canvasRect = d_data->canvas->contentsRect();
+
+    QRegion region;
+
+    const QRectF oldRect = d_data->paintRects.value( plotItem );
+    if ( oldRect.isValid() )
+        region += qwtDirtyRect( oldRect );
+
+    if ( plotItem->isVisible() )
+    {
+        const QRectF newRect = plotItem->paintBoundingRect( 
+            canvasMap( plotItem->xAxis() ), canvasMap( plotItem->yAxis() ),
+            canvasRect );
+
+        if ( newRect.isValid() )
+            region += qwtDirtyRect( newRect );
+    }
+
+    region &= QRegion( canvasRect );
+    if ( region.isEmpty() )
+        return;
+
+    const bool ok = QMetaObject::invokeMethod( d_data->canvas, 
+        "replotRegion", Qt::DirectConnection, Q_ARG( QRegion, region ) );
+    if ( !ok )
+    {
+        // fallback, when canvas has no replotRegion method
+        replot();
+    }
+}
+
 /*!
   Change the plot's title
   \param title New title
@@ -534,6 +994,28 @@ void QwtPlot::resizeEvent( QResizeEvent *e )
     updateLayout();
 }
 
+/*!
+  \brief Qt timer event
+
+  Scheduled replots are executed from a timer.
+
+  \param event Timer event
+  \sa setMaxReplotRate()
+ */
+void QwtPlot::timerEvent( QTimerEvent *event )
+{
+    if ( event->timerId() != d_data->replotTimerId )
+    {
+        QFrame::timerEvent( event );
+        return;
+    }
+
+    killTimer( d_data->replotTimerId );
+    d_data->replotTimerId = 0;
+
+    doReplot();
+}
+
 /*!
   \brief Redraw the plot
 
@@ -541,14 +1023,64 @@ void QwtPlot::resizeEvent( QResizeEvent *e )
   or if any curves are attached to raw data, the plot has to
   be refreshed explicitly in order to make changes visible.
 
-  \sa updateAxes(), setAutoReplot()
+  When a maximum replot rate has been set, the replot is
+  scheduled for the next frame instead.
+
+  \sa updateAxes(), setAutoReplot(), setMaxReplotRate()
 */
 void QwtPlot::replot()
 {
+    d_data->numReplotRequests++;
+
+    if ( d_data->maxReplotRate <= 0.0 )
+    {
+        doReplot();
+        return;
+    }
+
+    if ( d_data->replotTimerId != 0 )
+    {
+        // coalesced into the scheduled replot
+        d_data->numReplotsDropped++;
+        return;
+    }
+
+    int delay = 0;
+    if ( !d_data->replotClock.isNull() )
+    {
+        const double interval = 1000.0 / d_data->maxReplotRate;
+        delay = qMax( 0, qCeil( interval - d_data->replotClock.elapsed() ) );
+    }
+
+    /*
+      Even without delay we don't replot immediately, so that
+      all requests, that are already in the event queue are
+      collected into one replot.
+     */
+    d_data->replotTimerId = startTimer( delay );
+}
+
+void QwtPlot::doReplot()
+{
+    d_data->replotClock.start();
+    d_data->numReplotsRendered++;
+
     bool doAutoReplot = autoReplot();
     setAutoReplot( false );
 
-    updateAxes();
+    if ( d_data->plotAttributes & RecordFrames )
+    {
+        QwtSystemClock clock;
+        clock.start();
+
+        updateAxes();
+
+        d_data->frameRecord.updateAxesTime += clock.elapsed();
+    }
+    else
+    {
+        updateAxes();
+    }
 
     /*
       Maybe the layout needs to be updated, because of changed
@@ -577,6 +1109,10 @@ void QwtPlot::replot()
 */
 void QwtPlot::updateLayout()
 {
+    QwtSystemClock clock;
+    if ( d_data->plotAttributes & RecordFrames )
+        clock.start();
+
     d_data->layout->activate( this, contentsRect() );
 
     QRect titleRect = d_data->layout->titleRect().toRect();
@@ -650,6 +1186,15 @@ void QwtPlot::updateLayout()
     }
 
     d_data->canvas->setGeometry( canvasRect );
+
+    if ( d_data->plotAttributes & RecordFrames )
+    {
+        d_data->frameRecord.layoutTime += clock.elapsed();
+
+        d_data->frameRecord.numLayouts++;
+        if ( d_data->layout->isActivatedFromCache() )
+            d_data->frameRecord.numCachedLayouts++;
+    }
 }
 
 /*!
@@ -741,7 +1286,55 @@ void QwtPlot::drawCanvas( QPainter *painter )
     for ( int axisId = 0; axisId < axisCnt; axisId++ )
         maps[axisId] = canvasMap( axisId );
 
-    drawItems( painter, d_data->canvas->contentsRect(), maps );
+    const bool doRecord = d_data->plotAttributes & RecordFrames;
+
+    QwtSystemClock clock;
+    if ( doRecord )
+        clock.start();
+
+    const QRectF canvasRect = d_data->canvas->contentsRect();
+
+    d_data->recordItems = doRecord;
+    drawItems( painter, canvasRect, maps );
+    d_data->recordItems = false;
+
+    if ( d_data->plotAttributes & PartialReplot )
+    {
+        // remember the painted areas for the next partial replot
+
+        d_data->paintRects.clear();
+
+        const QwtPlotItemList& itmList = itemList();
+        for ( QwtPlotItemIterator it = itmList.begin();
+            it != itmList.end(); ++it )
+        {
+            const QwtPlotItem *item = *it;
+            if ( item && item->isVisible() )
+            {
+                d_data->paintRects.insert( item, item->paintBoundingRect( 
+                    maps[item->xAxis()], maps[item->yAxis()], canvasRect ) );
+            }
+        }
+    }
+
+    if ( doRecord )
+    {
+        QwtPlotFrameRecord record = d_data->frameRecord;
+        record.frame = d_data->numFrames++;
+        record.canvasTime = clock.elapsed();
+
+        d_data->frameRecord = QwtPlotFrameRecord();
+
+        if ( d_data->maxFrameRecords > 0 )
+        {
+            if ( d_data->frameRecords.size() >= d_data->maxFrameRecords )
+                d_data->frameRecords.removeFirst();
+
+            d_data->frameRecords += record;
+        }
+
+        Q_EMIT frameRecorded( record );
+    }
 }
 
 /*!
@@ -755,11 +1348,29 @@ void QwtPlot::drawCanvas( QPainter *painter )
         Due to a bug in Qt this rectangle might be wrong for certain 
         frame styles ( f.e QFrame::Box ) and it might be necessary to 
         fix the margins manually using QWidget::setContentsMargins()
+
+  \note In PartialReplot mode items, whose paint bounding rectangle 
+        doesn't intersect with the clip region of the painter are skipped.
+
+  \note When renderThreadCount() != 1 consecutive items with the
+        QwtPlotItem::ConcurrentRendering attribute are rendered in parallel.
 */
 
 void QwtPlot::drawItems( QPainter *painter, const QRectF &canvasRect,
         const QwtScaleMap maps[axisCnt] ) const
 {
+    QRectF dirtyRect;
+    if ( ( d_data->plotAttributes & PartialReplot ) && painter->hasClipping() )
+    {
+#if QT_VERSION >= 0x040800
+        dirtyRect = painter->clipBoundingRect();
+#else
+        dirtyRect = painter->clipRegion().boundingRect();
+#endif
+    }
+
+    QwtPlotItemList items;
+
     const QwtPlotItemList& itmList = itemList();
     for ( QwtPlotItemIterator it = itmList.begin();
         it != itmList.end(); ++it )
@@ -767,22 +1378,174 @@ void QwtPlot::drawItems( QPainter *painter, const QRectF &canvasRect,
         QwtPlotItem *item = *it;
         if ( item && item->isVisible() )
         {
-            painter->save();
+            if ( dirtyRect.isValid() )
+            {
+                const QRectF paintRect = item->paintBoundingRect( 
+                    maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+
+                if ( !paintRect.intersects( dirtyRect ) )
+                    continue;
+            }
+
+            items += item;
+        }
+    }
 
-            painter->setRenderHint( QPainter::Antialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
-            painter->setRenderHint( QPainter::HighQualityAntialiasing,
-                item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+    uint numThreads = 1;
 
-            item->draw( painter,
-                maps[item->xAxis()], maps[item->yAxis()],
-                canvasRect );
+#if QWT_USE_THREADS
+    numThreads = d_data->renderThreadCount;
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
 
-            painter->restore();
+    if ( numThreads <= 0 || !qwtCanRenderConcurrently( painter ) )
+        numThreads = 1;
+#endif
+
+    int i = 0;
+    while ( i < items.size() )
+    {
+        int numConcurrent = 0;
+        if ( numThreads > 1 )
+        {
+            while ( i + numConcurrent < items.size() && 
+                items[ i + numConcurrent ]->testItemAttribute( 
+                    QwtPlotItem::ConcurrentRendering ) )
+            {
+                numConcurrent++;
+            }
+        }
+
+        if ( numConcurrent > 1 )
+        {
+            drawLayers( painter, items.mid( i, numConcurrent ),
+                canvasRect, dirtyRect, maps, numThreads );
+
+            i += numConcurrent;
+        }
+        else
+        {
+            QwtPlotItem *item = items[i++];
+
+            QwtSystemClock clock;
+            if ( d_data->recordItems )
+            {
+                item->resetPaintStatistics();
+                clock.start();
+            }
+
+            qwtDrawItem( painter, item, maps, canvasRect );
+
+            if ( d_data->recordItems )
+                recordItem( item, clock.elapsed() );
         }
     }
 }
 
+/*!
+  Render a sequence of items in parallel threads into transparent
+  images and compose them in z order.
+
+  \param painter Painter
+  \param items Items in z order
+  \param canvasRect Bounding rectangle of the canvas
+  \param clipRect Area, that needs to be updated. 
+                  An invalid rectangle means the complete canvas
+  \param maps QwtPlot::axisCnt maps, mapping between plot and paint device coordinates
+  \param numThreads Number of threads
+
+  \sa setRenderThreadCount(), drawItems()
+ */
+void QwtPlot::drawLayers( QPainter *painter, const QwtPlotItemList &items,
+    const QRectF &canvasRect, const QRectF &clipRect,
+    const QwtScaleMap maps[axisCnt], uint numThreads ) const
+{
+#if QWT_USE_THREADS
+    const bool doRecord = d_data->recordItems;
+
+    QRectF rect = canvasRect;
+    if ( clipRect.isValid() )
+        rect &= clipRect;
+
+    const QRect layerRect = rect.toAlignedRect();
+    if ( layerRect.isEmpty() )
+        return;
+
+    qreal pixelRatio = 1.0;
+#if QT_VERSION >= 0x050000
+    pixelRatio = painter->device()->devicePixelRatio();
+#endif
+
+    const int numLayers = qMin( static_cast<int>( numThreads ), items.size() );
+
+    QVector<QwtPlotLayerCommand> commands( numLayers );
+    for ( int i = 0; i < numLayers; i++ )
+    {
+        // each layer gets a consecutive range of items, 
+        // so that the z order is not violated when composing
+
+        const int from = i * items.size() / numLayers;
+        const int to = ( i + 1 ) * items.size() / numLayers;
+
+        QwtPlotLayerCommand &command = commands[i];
+        command.items = items.mid( from, to - from );
+        command.maps = maps;
+        command.canvasRect = canvasRect;
+        command.layerRect = layerRect;
+        command.clipRect = clipRect;
+        command.pixelRatio = pixelRatio;
+        command.font = painter->font();
+        command.doRecord = doRecord;
+
+        if ( doRecord )
+        {
+            for ( int j = 0; j < command.items.size(); j++ )
+                command.items[j]->resetPaintStatistics();
+        }
+    }
+
+    QList< QFuture<void> > futures;
+    for ( int i = 0; i < numLayers - 1; i++ )
+        futures += QtConcurrent::run( &qwtRenderLayer, &commands[i] );
+
+    qwtRenderLayer( &commands[ numLayers - 1 ] );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+
+    for ( int i = 0; i < numLayers; i++ )
+    {
+        const QwtPlotLayerCommand &command = commands[i];
+
+        painter->drawImage( layerRect.topLeft(), command.image );
+
+        if ( doRecord )
+        {
+            for ( int j = 0; j < command.items.size(); j++ )
+                recordItem( command.items[j], command.drawTimes[j] );
+        }
+    }
+#else
+    Q_UNUSED( clipRect )
+    Q_UNUSED( numThreads )
+
+    for ( int i = 0; i < items.size(); i++ )
+        qwtDrawItem( painter, items[i], maps, canvasRect );
+#endif
+}
+
+void QwtPlot::recordItem( const QwtPlotItem *item, double drawTime ) const
+{
+    QwtPlotItemRecord record;
+    record.item = item;
+    record.rtti = item->rtti();
+    record.title = item->title().text();
+    record.drawTime = drawTime;
+    item->getPaintStatistics( record.numSamples, record.numPoints );
+
+    d_data->frameRecord.items += record;
+}
+
 /*!
   \param axisId Axis
   \return Map for the axis on the canvas. With this map pixel coordinates can
@@ -953,28 +1716,17 @@ void QwtPlot::insertLegend( QwtAbstractLegend *legend,
             updateLegend();
             qwtEnableLegendItems( this, true );
 
+            const LegendPosition legendPos =
+                d_data->layout->legendPosition();
+
             QwtLegend *lgd = qobject_cast<QwtLegend *>( legend );
             if ( lgd )
-            {
-                switch ( d_data->layout->legendPosition() )
-                {
-                    case LeftLegend:
-                    case RightLegend:
-                    {
-                        if ( lgd->maxColumns() == 0     )
-                            lgd->setMaxColumns( 1 ); // 1 column: align vertical
-                        break;
-                    }
-                    case TopLegend:
-                    case BottomLegend:
-                    {
-                        lgd->setMaxColumns( 0 ); // unlimited
-                        break;
-                    }
-                    default:
-                        break;
-                }
-            }
+                qwtAdjustLegendColumns( lgd, legendPos );
+
+            QwtVirtualLegend *virtualLgd =
+                qobject_cast<QwtVirtualLegend *>( legend );
+            if ( virtualLgd )
+                qwtAdjustLegendColumns( virtualLgd, legendPos );
 
             QWidget *previousInChain = NULL;
             switch ( d_data->layout->legendPosition() )
@@ -1035,6 +1787,10 @@ void QwtPlot::updateLegend( const QwtPlotItem *plotItem )
     if ( plotItem == NULL )
         return;
 
+    QwtSystemClock clock;
+    if ( d_data->plotAttributes & RecordFrames )
+        clock.start();
+
     QList<QwtLegendData> legendData;
 
     if ( plotItem->testItemAttribute( QwtPlotItem::Legend ) )
@@ -1042,6 +1798,9 @@ void QwtPlot::updateLegend( const QwtPlotItem *plotItem )
 
     const QVariant itemInfo = itemToInfo( const_cast< QwtPlotItem *>( plotItem) );
     Q_EMIT legendDataChanged( itemInfo, legendData );
+
+    if ( d_data->plotAttributes & RecordFrames )
+        d_data->frameRecord.legendTime += clock.elapsed();
 }
 
 /*!
@@ -1101,9 +1860,14 @@ void QwtPlot::attachItem( QwtPlotItem *plotItem, bool on )
     }
 
     if ( on )
+    {
         insertItem( plotItem );
+    }
     else 
+    {
         removeItem( plotItem );
+        d_data->paintRects.remove( plotItem );
+    }
 
     Q_EMIT itemAttached( plotItem, on );
 
@@ -15,6 +15,7 @@
 #include "qwt_plot_dict.h"
 #include "qwt_scale_map.h"
 #include "qwt_interval.h"
+#include "qwt_plot_frame_record.h"
 #include <qframe.h>
 #include <qlist.h>
 #include <qvariant.h>
@@ -128,6 +129,49 @@ public:
         TopLegend
     };
 
+    /*!
+        \brief Plot attributes
+
+        The default setting disables all attributes.
+
+        \sa setPlotAttribute(), testPlotAttribute()
+     */
+    enum PlotAttribute
+    {
+        /*!
+          When an item has changed in autoReplot() mode, only
+          the areas of its previous and current
+          QwtPlotItem::paintBoundingRect() are repainted. Only the items
+          intersecting these areas are painted - clipped to them.
+
+          When the change of the item might have an effect on the
+          scales or the canvas margins the plot falls back to a
+          complete replot().
+
+          Partial replots need a canvas, that implements a
+          replotRegion() meta method ( f.e. QwtPlotCanvas with 
+          QwtPlotCanvas::BackingStore enabled ). Otherwise the
+          plot falls back to replot().
+
+          \sa QwtPlotItem::paintBoundingRect(), QwtPlotCanvas::replotRegion()
+         */
+        PartialReplot = 0x01,
+
+        /*!
+          Record timings of each replot cycle: updateAxes(), 
+          updateLayout(), updates of the legend, painting of the scales
+          and QwtPlotItem::draw() for each item on the canvas.
+          The item records also include the number of processed 
+          samples and painted points, when the item reports them.
+
+          \sa QwtPlotFrameRecord, frameRecords(), frameRecorded()
+         */
+        RecordFrames = 0x02
+    };
+
+    //! Plot attributes
+    typedef QFlags<PlotAttribute> PlotAttributes;
+
     explicit QwtPlot( QWidget * = NULL );
     explicit QwtPlot( const QwtText &title, QWidget * = NULL );
 
@@ -139,6 +183,24 @@ public:
     void setAutoReplot( bool = true );
     bool autoReplot() const;
 
+    void setPlotAttribute( PlotAttribute, bool on = true );
+    bool testPlotAttribute( PlotAttribute ) const;
+
+    void setMaxReplotRate( double rate );
+    double maxReplotRate() const;
+
+    void getReplotStatistics( uint &requested, 
+        uint &rendered, uint &dropped ) const;
+    void resetReplotStatistics();
+
+    void setMaxFrameRecords( int );
+    int maxFrameRecords() const;
+
+    void setRenderThreadCount( uint numThreads );
+    uint renderThreadCount() const;
+
+    QList<QwtPlotFrameRecord> frameRecords() const;
+
     // Layout
 
     void setPlotLayout( QwtPlotLayout * );
@@ -279,6 +341,16 @@ Q_SIGNALS:
     void legendDataChanged( const QVariant &itemInfo, 
         const QList<QwtLegendData> &data );
 
+    /*!
+      A signal, that is emitted, when the canvas has been painted
+      in RecordFrames mode
+
+      \param record Timings of the replot cycle
+
+      \sa RecordFrames, frameRecords()
+     */
+    void frameRecorded( const QwtPlotFrameRecord &record );
+
 public Q_SLOTS:
     virtual void replot();
     void autoRefresh();
@@ -287,6 +359,7 @@ protected:
     static bool axisValid( int axisId );
 
     virtual void resizeEvent( QResizeEvent *e );
+    virtual void timerEvent( QTimerEvent *e );
 
 private Q_SLOTS:
     void updateLegendItems( const QVariant &itemInfo,
@@ -295,12 +368,20 @@ private Q_SLOTS:
 private:
     friend class QwtPlotItem;
     void attachItem( QwtPlotItem *, bool );
+    void autoRefreshItem( QwtPlotItem * );
 
     void initAxesData();
     void deleteAxesData();
     void updateScaleDiv();
 
     void initPlot( const QwtText &title );
+    void doReplot();
+
+    void drawLayers( QPainter *, const QwtPlotItemList &,
+        const QRectF &canvasRect, const QRectF &clipRect,
+        const QwtScaleMap maps[axisCnt], uint numThreads ) const;
+
+    void recordItem( const QwtPlotItem *, double drawTime ) const;
 
     class AxisData;
     AxisData *d_axisData[axisCnt];
@@ -309,4 +390,6 @@ private:
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlot::PlotAttributes )
+
 #endif
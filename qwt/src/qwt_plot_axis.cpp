@@ -12,6 +12,91 @@
 #include "qwt_scale_widget.h"
 #include "qwt_scale_div.h"
 #include "qwt_scale_engine.h"
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined(QT_NO_QFUTURE)
+#define QWT_USE_THREADS 1
+#endif
+
+#if QWT_USE_THREADS
+
+static void qwtCalculateBoundingRects( const QwtPlotItemList items,
+    int from, int step, QRectF *rects )
+{
+    for ( int i = from; i < items.size(); i += step )
+        rects[i] = items[i]->boundingRect();
+}
+
+#endif
+
+static QVector<QRectF> qwtBoundingRects(
+    const QwtPlotItemList &items, uint numThreads )
+{
+    QVector<QRectF> rects( items.size() );
+
+#if QWT_USE_THREADS
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    if ( numThreads > 1 && items.size() > 1 )
+    {
+        // calculating the bounding rectangles - usually iterations
+        // over all samples, when the data has been changed - in parallel
+
+        QwtPlotItemList concurrentItems;
+        QVector<int> indexes;
+
+        for ( int i = 0; i < items.size(); i++ )
+        {
+            if ( items[i]->testItemAttribute(
+                QwtPlotItem::ConcurrentBoundingRect ) )
+            {
+                concurrentItems += items[i];
+                indexes += i;
+            }
+            else
+            {
+                rects[i] = items[i]->boundingRect();
+            }
+        }
+
+        if ( concurrentItems.isEmpty() )
+            return rects;
+
+        QVector<QRectF> concurrentRects( concurrentItems.size() );
+
+        const int step = qMin( static_cast<int>( numThreads ),
+            concurrentItems.size() );
+
+        QList< QFuture<void> > futures;
+        for ( int i = 1; i < step; i++ )
+        {
+            futures += QtConcurrent::run( &qwtCalculateBoundingRects,
+                concurrentItems, i, step, concurrentRects.data() );
+        }
+
+        qwtCalculateBoundingRects( concurrentItems,
+            0, step, concurrentRects.data() );
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+
+        for ( int i = 0; i < indexes.size(); i++ )
+            rects[ indexes[i] ] = concurrentRects[i];
+
+        return rects;
+    }
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    for ( int i = 0; i < items.size(); i++ )
+        rects[i] = items[i]->boundingRect();
+
+    return rects;
+}
 
 class QwtPlot::AxisData
 {
@@ -634,6 +719,10 @@ void QwtPlot::setAxisTitle( int axisId, const QwtText &title )
 
   updateAxes() is usually called by replot(). 
 
+  \note When renderThreadCount() != 1 the bounding rectangles of the
+        items with the QwtPlotItem::ConcurrentBoundingRect attribute
+        are calculated in parallel threads.
+
   \sa setAxisAutoScale(), setAxisScale(), setAxisScaleDiv(), replot()
       QwtPlotItem::boundingRect()
  */
@@ -646,10 +735,12 @@ void QwtPlot::updateAxes()
 
     const QwtPlotItemList& itmList = itemList();
 
+    QwtPlotItemList items;
+
     QwtPlotItemIterator it;
     for ( it = itmList.begin(); it != itmList.end(); ++it )
     {
-        const QwtPlotItem *item = *it;
+        QwtPlotItem *item = *it;
 
         if ( !item->testItemAttribute( QwtPlotItem::AutoScale ) )
             continue;
@@ -658,15 +749,22 @@ void QwtPlot::updateAxes()
             continue;
 
         if ( axisAutoScale( item->xAxis() ) || axisAutoScale( item->yAxis() ) )
-        {
-            const QRectF rect = item->boundingRect();
+            items += item;
+    }
 
-            if ( rect.width() >= 0.0 )
-                intv[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
+    const QVector<QRectF> rects =
+        qwtBoundingRects( items, renderThreadCount() );
 
-            if ( rect.height() >= 0.0 )
-                intv[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
-        }
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem *item = items[i];
+        const QRectF &rect = rects[i];
+
+        if ( rect.width() >= 0.0 )
+            intv[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
+
+        if ( rect.height() >= 0.0 )
+            intv[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
     }
 
     // Adjust scales
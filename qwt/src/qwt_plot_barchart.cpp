@@ -12,13 +12,17 @@
 #include "qwt_column_symbol.h"
 #include "qwt_painter.h"
 #include <qpainter.h>
+#include <qmath.h>
+#include <qdatastream.h>
+#include <typeinfo>
 
 class QwtPlotBarChart::PrivateData
 {
 public:
     PrivateData():
         symbol( NULL ),
-        legendMode( QwtPlotBarChart::LegendChartTitle )
+        legendMode( QwtPlotBarChart::LegendChartTitle ),
+        paintAttributes( 0 )
     {
     }
  
@@ -29,6 +33,7 @@ public:
 
     QwtColumnSymbol *symbol;
     QwtPlotBarChart::LegendMode legendMode;
+    QwtPlotBarChart::PaintAttributes paintAttributes;
 };
 
 /*!
@@ -61,6 +66,8 @@ void QwtPlotBarChart::init()
 {
     d_data = new PrivateData;
     setData( new QwtPointSeriesData() );
+
+    setConcurrentRenderingType( typeid( QwtPlotBarChart ) );
 }
 
 //! \return QwtPlotItem::Rtti_PlotBarChart
@@ -69,6 +76,32 @@ int QwtPlotBarChart::rtti() const
     return QwtPlotItem::Rtti_PlotBarChart;
 }
 
+/*!
+  Specify an attribute how to draw the bar chart
+
+  \param attribute Paint attribute
+  \param on On/Off
+  \sa testPaintAttribute()
+*/
+void QwtPlotBarChart::setPaintAttribute(
+    PaintAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->paintAttributes |= attribute;
+    else
+        d_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa PaintAttribute, setPaintAttribute()
+*/
+bool QwtPlotBarChart::testPaintAttribute(
+    PaintAttribute attribute ) const
+{
+    return ( d_data->paintAttributes & attribute );
+}
+
 /*!
   Initialize data with an array of points
 
@@ -234,15 +267,126 @@ void QwtPlotBarChart::drawSeries( QPainter *painter,
 
     painter->save();
 
-    for ( int i = from; i <= to; i++ )
+    if ( d_data->paintAttributes & MergeBars )
     {
-        drawSample( painter, xMap, yMap,
-                    canvasRect, interval, i, sample( i ) );
+        drawMergedBars( painter, xMap, yMap, 
+            canvasRect, interval, from, to );
+    }
+    else
+    {
+        for ( int i = from; i <= to; i++ )
+        {
+            drawSample( painter, xMap, yMap,
+                canvasRect, interval, i, sample( i ) );
+        }
     }
 
     painter->restore();
 }
 
+/*!
+  Draw an interval of the bar chart, merging thin bars
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param canvasRect Contents rect of the canvas
+  \param boundingInterval Bounding interval of sample values
+  \param from Index of the first point to be painted
+  \param to Index of the last point to be painted
+
+  \sa MergeBars, drawSeries()
+*/
+void QwtPlotBarChart::drawMergedBars( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, const QwtInterval &boundingInterval,
+    int from, int to ) const
+{
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    QwtColumnSymbol defaultSymbol( QwtColumnSymbol::Box );
+    defaultSymbol.setLineWidth( 1 );
+    defaultSymbol.setFrameStyle( QwtColumnSymbol::Plain );
+
+    const QwtColumnSymbol *symbol = d_data->symbol;
+    if ( symbol == NULL )
+        symbol = &defaultSymbol;
+
+    const bool hasFrame = ( symbol->frameStyle() != QwtColumnSymbol::NoFrame )
+        && ( symbol->lineWidth() > 0 );
+
+    const QBrush brush = hasFrame 
+        ? symbol->palette().dark() : symbol->palette().window();
+
+    QVector<QRectF> rects;
+    int numRects = 0;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF sample = this->sample( i );
+        const QwtColumnRect rect = columnRect( xMap, yMap,
+            canvasRect, boundingInterval, sample );
+
+        if ( doAlign && symbol->style() == QwtColumnSymbol::Box )
+        {
+            QRectF r = rect.toRect();
+            r.setLeft( qRound( r.left() ) );
+            r.setRight( qRound( r.right() ) );
+            r.setTop( qRound( r.top() ) );
+            r.setBottom( qRound( r.bottom() ) );
+
+            const bool isThin = ( orientation() == Qt::Vertical ) 
+                ? ( r.width() <= 1.0 ) : ( r.height() <= 1.0 );
+
+            if ( isThin )
+            {
+                QwtColumnSymbol *specialSym = specialSymbol( i, sample );
+                if ( specialSym == NULL )
+                {
+                    QwtPainter::addColumnRect( rects, r, orientation() );
+                    continue;
+                }
+
+                delete specialSym;
+            }
+        }
+
+        if ( !rects.isEmpty() )
+        {
+            painter->save();
+            painter->setPen( Qt::NoPen );
+            painter->setBrush( brush );
+
+            // a thin bar covers at least one pixel
+            for ( int j = 0; j < rects.size(); j++ )
+                rects[j].adjust( 0, 0, 1, 1 );
+
+            QwtPainter::drawRects( painter, rects.constData(), rects.size() );
+            painter->restore();
+
+            numRects += rects.size();
+            rects.clear();
+        }
+
+        drawBar( painter, i, sample, rect );
+        numRects++;
+    }
+
+    if ( !rects.isEmpty() )
+    {
+        painter->setPen( Qt::NoPen );
+        painter->setBrush( brush );
+
+        for ( int j = 0; j < rects.size(); j++ )
+            rects[j].adjust( 0, 0, 1, 1 );
+
+        QwtPainter::drawRects( painter, rects.constData(), rects.size() );
+        numRects += rects.size();
+    }
+
+    addPaintStatistics( to - from + 1, numRects );
+}
+
 /*!
   Draw a sample
 
@@ -260,6 +404,29 @@ void QwtPlotBarChart::drawSample( QPainter *painter,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
     const QRectF &canvasRect, const QwtInterval &boundingInterval,
     int index, const QPointF &sample ) const
+{
+    const QwtColumnRect barRect = columnRect( xMap, yMap,
+        canvasRect, boundingInterval, sample );
+
+    drawBar( painter, index, sample, barRect );
+}
+
+/*!
+  Calculate the bounding rectangle of a bar
+
+  \param xMap x map
+  \param yMap y map
+  \param canvasRect Contents rect of the canvas
+  \param boundingInterval Bounding interval of sample values
+  \param sample Value of the sample
+
+  \return Bounding rectangle of the bar in paint device coordinates
+  \sa drawSample()
+*/
+QwtColumnRect QwtPlotBarChart::columnRect(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, const QwtInterval &boundingInterval,
+    const QPointF &sample ) const
 {
     QwtColumnRect barRect;
 
@@ -300,7 +467,7 @@ void QwtPlotBarChart::drawSample( QPainter *painter,
         barRect.vInterval = QwtInterval( y1, y2 ).normalized();
     }
 
-    drawBar( painter, index, sample, barRect );
+    return barRect;
 }
 
 /*!
@@ -401,13 +568,19 @@ QList<QwtLegendData> QwtPlotBarChart::legendData() const
             qVariantSetValue( titleValue, barTitle( i ) );
             data.setValue( QwtLegendData::TitleRole, titleValue );
 
-            if ( !legendIconSize().isEmpty() )
+            const QSizeF iconSize = legendIconSize();
+            if ( !iconSize.isEmpty() )
             {
+                const QByteArray iconKey = legendIconKey( i, iconSize );
+
                 QVariant iconValue;
                 qVariantSetValue( iconValue,
-                    legendIcon( i, legendIconSize() ) );
+                    cachedLegendIcon( iconKey, i, iconSize ) );
 
                 data.setValue( QwtLegendData::IconRole, iconValue );
+
+                if ( !iconKey.isEmpty() )
+                    data.setValue( QwtLegendData::IconKeyRole, iconKey );
             }
 
             list += data;
@@ -457,3 +630,47 @@ QwtGraphic QwtPlotBarChart::legendIcon(
 
     return icon;
 }
+
+/*!
+   \return Key including all attributes, that have an effect on legendIcon()
+
+   As QwtPlotBarChart itself doesn't return special symbols
+   the key doesn't depend on the index.
+
+   \param index Index of the legend entry
+   \param size Icon size
+
+   \note For derived classes an empty key is returned, as they usually
+         reimplement specialSymbol()
+   \sa QwtPlotItem::legendIconKey(), QwtPlotItem::legendData()
+ */
+QByteArray QwtPlotBarChart::legendIconKey(
+    int index, const QSizeF &size ) const
+{
+    Q_UNUSED( index );
+
+    if ( size.isEmpty() || typeid( *this ) != typeid( QwtPlotBarChart ) )
+        return QByteArray();
+
+    const QwtColumnSymbol *symbol = d_data->symbol;
+    if ( symbol && typeid( *symbol ) != typeid( QwtColumnSymbol ) )
+        return QByteArray();
+
+    QByteArray key;
+
+    QDataStream stream( &key, QIODevice::WriteOnly );
+    stream << rtti() << size
+        << testRenderHint( QwtPlotItem::RenderAntialiased );
+
+    if ( symbol )
+    {
+        stream << int( symbol->style() ) << int( symbol->frameStyle() )
+            << symbol->lineWidth() << symbol->palette();
+    }
+    else
+    {
+        stream << int( -1 );
+    }
+
+    return key;
+}
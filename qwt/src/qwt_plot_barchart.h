@@ -67,6 +67,35 @@ public:
         LegendBarTitles
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        \sa setPaintAttribute(), testPaintAttribute()
+    */
+    enum PaintAttribute
+    {
+        /*!
+          When drawing to a paint device in integer coordinates
+          ( f.e. all widgets on screen ) consecutive bars, that are not 
+          wider than a pixel and are mapped to the same pixel column
+          are merged into one rectangle, that covers the minimum and
+          the maximum of their values. The merged bars are painted in 
+          batches using QwtPainter::drawRects().
+
+          For charts with many more bars than pixels the number of 
+          rectangles to be painted is limited by the size of the plot canvas.
+
+          \note Only bars without a specialSymbol() are merged. As a 
+                 thin bar has no space for a frame it is filled with the
+                 frame color of the symbol().
+          \note The merged bars are painted without calling drawSample()
+                 and drawBar()
+         */
+        MergeBars = 0x01
+    };
+
+    //! Paint attributes
+    typedef QFlags<PaintAttribute> PaintAttributes;
+
     explicit QwtPlotBarChart( const QString &title = QString::null );
     explicit QwtPlotBarChart( const QwtText &title );
 
@@ -74,6 +103,9 @@ public:
 
     virtual int rtti() const;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setSamples( const QVector<QPointF> & );
     void setSamples( const QVector<double> & );
     void setSamples( QwtSeriesData<QPointF> *series );
@@ -107,12 +139,25 @@ protected:
 
     QList<QwtLegendData> legendData() const;
     QwtGraphic legendIcon( int index, const QSizeF & ) const;
+    QByteArray legendIconKey( int index, const QSizeF & ) const;
 
 private:
     void init();
 
+    QwtColumnRect columnRect( 
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, const QwtInterval &boundingInterval,
+        const QPointF &sample ) const;
+
+    void drawMergedBars( QPainter *painter,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, const QwtInterval &boundingInterval,
+        int from, int to ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotBarChart::PaintAttributes )
+
 #endif
@@ -657,6 +657,7 @@ public:
 #endif
 
     QPixmap *backingStore;
+    QRegion dirtyRegion;
 
     struct StyleSheet
     {
@@ -797,6 +798,8 @@ void QwtPlotCanvas::invalidateBackingStore()
 {
     if ( d_data->backingStore )
         *d_data->backingStore = QPixmap();
+
+    d_data->dirtyRegion = QRegion();
 }
 
 /*!
@@ -881,9 +884,18 @@ void QwtPlotCanvas::paintEvent( QPaintEvent *event )
         d_data->backingStore != NULL )
     {
         QPixmap &bs = *d_data->backingStore;
-        if ( bs.size() != size() )
+
+        // an empty clip region means: repaint everything
+        QRegion clipRegion;
+        if ( bs.size() == size() )
+            clipRegion = d_data->dirtyRegion;
+
+        d_data->dirtyRegion = QRegion();
+
+        if ( bs.size() != size() || !clipRegion.isEmpty() )
         {
-            bs = QwtPainter::backingStore( this, size() );
+            if ( bs.size() != size() )
+                bs = QwtPainter::backingStore( this, size() );
 
 #ifndef QWT_NO_OPENGL
             if ( testPaintAttribute( OpenGLBuffer ) )
@@ -897,6 +909,9 @@ void QwtPlotCanvas::paintEvent( QPaintEvent *event )
             if ( testAttribute(Qt::WA_StyledBackground) )
             {
                 QPainter p( &bs );
+                if ( !clipRegion.isEmpty() )
+                    p.setClipRegion( clipRegion );
+
                 qwtFillBackground( &p, this );
                 drawCanvas( &p, true );
             }
@@ -905,13 +920,31 @@ void QwtPlotCanvas::paintEvent( QPaintEvent *event )
                 QPainter p;
                 if ( d_data->borderRadius <= 0.0 )
                 {
-                    QwtPainter::fillPixmap( this, bs );
-                    p.begin( &bs );
+                    if ( clipRegion.isEmpty() )
+                    {
+                        QwtPainter::fillPixmap( this, bs );
+                        p.begin( &bs );
+                    }
+                    else
+                    {
+                        p.begin( &bs );
+                        p.setClipRegion( clipRegion );
+
+                        const QRect r = clipRegion.boundingRect();
+
+                        QPixmap pm( r.size() );
+                        QwtPainter::fillPixmap( this, pm, r.topLeft() );
+                        p.drawPixmap( r.topLeft(), pm );
+                    }
+
                     drawCanvas( &p, false );
                 }
                 else
                 {
                     p.begin( &bs );
+                    if ( !clipRegion.isEmpty() )
+                        p.setClipRegion( clipRegion );
+
                     qwtFillBackground( &p, this );
                     drawCanvas( &p, true );
                 }
@@ -1144,6 +1177,48 @@ void QwtPlotCanvas::replot()
         update( contentsRect() );
 }
 
+/*!
+   \brief Repaint a part of the canvas
+
+   Only the plot items intersecting the region are painted - clipped
+   to the region. When a backing store is enabled the region is updated
+   in the backing store, while the rest of it is reused.
+
+   When the backing store is invalid, or in OpenGLBuffer mode, the
+   complete canvas is replotted.
+
+   \param region Region of the canvas, that needs to be repainted
+   \sa replot(), QwtPlot::PartialReplot
+*/
+void QwtPlotCanvas::replotRegion( const QRegion &region )
+{
+    if ( testPaintAttribute( QwtPlotCanvas::OpenGLBuffer ) )
+    {
+        replot();
+        return;
+    }
+
+    const QRegion dirtyRegion = region & QRegion( contentsRect() );
+    if ( dirtyRegion.isEmpty() )
+        return;
+
+    if ( d_data->backingStore )
+    {
+        if ( d_data->backingStore->size() != size() )
+        {
+            replot();
+            return;
+        }
+
+        d_data->dirtyRegion += dirtyRegion;
+    }
+
+    if ( testPaintAttribute( QwtPlotCanvas::ImmediatePaint ) )
+        repaint( dirtyRegion );
+    else
+        update( dirtyRegion );
+}
+
 //! Update the cached information about the current style sheet
 void QwtPlotCanvas::updateStyleSheetInfo()
 {
@@ -179,6 +179,7 @@ public:
 
 public Q_SLOTS:
     void replot();
+    void replotRegion( const QRegion & );
 
 protected:
     virtual void paintEvent( QPaintEvent * );
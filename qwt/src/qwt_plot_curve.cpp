@@ -17,10 +17,20 @@
 #include "qwt_spline_curve_fitter.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
+#include "qwt_color_map.h"
 #include <qpainter.h>
+#include <qpainterpath.h>
+#include <qtransform.h>
 #include <qpixmap.h>
+#include <qimage.h>
 #include <qalgorithms.h>
 #include <qmath.h>
+#include <qnumeric.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+#include <qdatastream.h>
+#include <typeinfo>
 
 static inline QRectF qwtIntersectedClipRect( const QRectF &rect, QPainter *painter )
 {
@@ -61,6 +71,50 @@ static void qwtUpdateLegendIconSize( QwtPlotCurve *curve )
     }
 }
 
+static bool qwtAppendSymbolKey( QDataStream &stream, const QwtSymbol *symbol )
+{
+    if ( symbol == NULL )
+    {
+        stream << int( QwtSymbol::NoSymbol );
+        return true;
+    }
+
+    // derived symbols might paint anything
+    if ( typeid( *symbol ) != typeid( QwtSymbol )
+        || symbol->style() >= QwtSymbol::UserStyle )
+    {
+        return false;
+    }
+
+    stream << int( symbol->style() );
+
+    switch( symbol->style() )
+    {
+        case QwtSymbol::Path:
+        {
+            stream << symbol->path();
+            break;
+        }
+        case QwtSymbol::Pixmap:
+        {
+            stream << symbol->pixmap().cacheKey();
+            break;
+        }
+        case QwtSymbol::Graphic:
+        case QwtSymbol::SvgDocument:
+        {
+            return false;
+        }
+        default:
+            break;
+    }
+
+    stream << symbol->size() << symbol->brush() << symbol->pen()
+        << symbol->isPinPointEnabled() << symbol->pinPoint();
+
+    return true;
+}
+
 static int qwtVerifyRange( int size, int &i1, int &i2 )
 {
     if ( size < 1 )
@@ -75,6 +129,259 @@ static int qwtVerifyRange( int size, int &i1, int &i2 )
     return ( i2 - i1 + 1 );
 }
 
+static inline bool qwtIsLinear( const QwtScaleMap &map )
+{
+    return ( map.transformation() == NULL ) && ( map.s1() != map.s2() );
+}
+
+static QPolygonF qwtSamples( const QwtSeriesData<QPointF> *series,
+    int from, int to )
+{
+    QPolygonF points( to - from + 1 );
+
+    QPointF *p = points.data();
+    for ( int i = from; i <= to; i++ )
+        *p++ = series->sample( i );
+
+    return points;
+}
+
+class QwtPlotCurveFitCache
+{
+public:
+    enum
+    {
+        // number of samples per segment
+        SegmentSize = 1024
+    };
+
+    QwtPlotCurveFitCache():
+        series( NULL ),
+        dataRevision( 0 ),
+        fitter( NULL ),
+        fitterRevision( 0 ),
+        fitPath( false ),
+        numSamples( 0 )
+    {
+    }
+
+    void invalidate()
+    {
+        series = NULL;
+        fitter = NULL;
+        numSamples = 0;
+
+        polygons.clear();
+        paths.clear();
+
+        polygon.clear();
+        path = QPainterPath();
+    }
+
+    void update( const QwtSeriesData<QPointF> *, uint dataRevision,
+        const QwtCurveFitter *, bool fitPath );
+
+    const QwtSeriesData<QPointF> *series;
+    uint dataRevision;
+
+    const QwtCurveFitter *fitter;
+    uint fitterRevision;
+    bool fitPath;
+
+    int numSamples;
+
+    // the fitted segments and their concatenation
+    QVector<QPolygonF> polygons;
+    QVector<QPainterPath> paths;
+
+    QPolygonF polygon;
+    QPainterPath path;
+};
+
+void QwtPlotCurveFitCache::update( const QwtSeriesData<QPointF> *series,
+    uint dataRevision, const QwtCurveFitter *fitter, bool fitPath )
+{
+    const int size = static_cast<int>( series->size() );
+
+    bool isValid = ( series == this->series ) 
+        && ( dataRevision == this->dataRevision )
+        && ( fitter == this->fitter )
+        && ( fitter->revision() == fitterRevision )
+        && ( fitPath == this->fitPath ) && ( size >= numSamples );
+
+    /*
+      Data objects might be modified without notification. Only
+      appended samples are detected, all other modifications
+      have to be indicated by dataChanged(), what increments dataRevision.
+     */
+
+    if ( isValid && size == numSamples )
+        return;
+
+    if ( !isValid )
+    {
+        invalidate();
+
+        this->series = series;
+        this->dataRevision = dataRevision;
+        this->fitter = fitter;
+        this->fitterRevision = fitter->revision();
+        this->fitPath = fitPath;
+    }
+
+    // segment i covers the samples [ i * SegmentSize, ( i + 1 ) * SegmentSize ]
+    // so that neighboured segments share one sample. All segments
+    // but the last one are complete and don't need to be refitted.
+
+    const int numSegments = ( numSamples > 0 ) 
+        ? ( numSamples - 1 ) / SegmentSize : 0;
+
+    if ( fitPath )
+        paths.resize( numSegments );
+    else
+        polygons.resize( numSegments );
+
+    for ( int from = numSegments * SegmentSize; 
+        from < size - 1 || from == 0; from += SegmentSize )
+    {
+        const int to = qMin( from + SegmentSize, size - 1 );
+        const QPolygonF points = qwtSamples( series, from, to );
+
+        if ( fitPath )
+            paths += fitter->fitCurvePath( points );
+        else
+            polygons += fitter->fitCurve( points );
+
+        if ( to == size - 1 )
+            break;
+    }
+
+    numSamples = size;
+
+    if ( fitPath )
+    {
+        path = QPainterPath();
+        for ( int i = 0; i < paths.size(); i++ )
+        {
+            if ( i == 0 )
+                path = paths[i];
+            else
+                path.connectPath( paths[i] );
+        }
+    }
+    else
+    {
+        polygon.clear();
+        for ( int i = 0; i < polygons.size(); i++ )
+        {
+            const QPolygonF &segment = polygons[i];
+            if ( segment.isEmpty() )
+                continue;
+
+            // skipping the sample, that is shared with the previous segment
+            const int offset = ( !polygon.isEmpty() 
+                && polygon.last() == segment.first() ) ? 1 : 0;
+
+            const int oldSize = polygon.size();
+            polygon.resize( oldSize + segment.size() - offset );
+
+            QPointF *points = polygon.data() + oldSize;
+            for ( int j = offset; j < segment.size(); j++ )
+                *points++ = segment[j];
+        }
+    }
+}
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtDensityCommand
+{
+public:
+    const QwtSeriesData<QPointF> *series;
+    int from;
+    int to;
+};
+
+static void qwtCountPoints(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtDensityCommand command, const QRect &rect, quint32 *counts )
+{
+    const double w = rect.width();
+    const double h = rect.height();
+
+    // pixel centers are at integer positions
+    const double x0 = rect.left() - 0.5;
+    const double y0 = rect.top() - 0.5;
+
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QPointF sample = command.series->sample( i );
+
+        const double x = xMap.transform( sample.x() ) - x0;
+        const double y = yMap.transform( sample.y() ) - y0;
+
+        // also sorting out NaNs
+        if ( x >= 0.0 && x < w && y >= 0.0 && y < h )
+        {
+            const int index = static_cast<int>( y ) * rect.width()
+                + static_cast<int>( x );
+
+            counts[index]++;
+        }
+    }
+}
+
+class QwtPlotCurveDensityCache
+{
+public:
+    QwtPlotCurveDensityCache():
+        series( NULL ),
+        dataRevision( 0 ),
+        numSamples( 0 ),
+        from( 0 ),
+        to( -1 )
+    {
+    }
+
+    void invalidate()
+    {
+        series = NULL;
+        counts.clear();
+    }
+
+    bool isValid( const QwtSeriesData<QPointF> *series, uint dataRevision,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRect &rect, int from, int to ) const
+    {
+        return ( series != NULL ) && ( series == this->series )
+            && ( dataRevision == this->dataRevision )
+            && ( series->size() == numSamples )
+            && ( from == this->from ) && ( to == this->to )
+            && ( rect == this->rect )
+            && qwtIsLinear( xMap ) && qwtIsLinear( yMap )
+            && isEqual( xMap, this->xMap ) && isEqual( yMap, this->yMap );
+    }
+
+    const QwtSeriesData<QPointF> *series;
+    uint dataRevision;
+    size_t numSamples;
+    int from;
+    int to;
+
+    QwtScaleMap xMap;
+    QwtScaleMap yMap;
+    QRect rect;
+
+    QVector<quint32> counts;
+
+private:
+    static inline bool isEqual( const QwtScaleMap &map1, const QwtScaleMap &map2 )
+    {
+        return ( map1.s1() == map2.s1() ) && ( map1.s2() == map2.s2() )
+            && ( map1.p1() == map2.p1() ) && ( map1.p2() == map2.p2() );
+    }
+};
+
 class QwtPlotCurve::PrivateData
 {
 public:
@@ -85,7 +392,9 @@ public:
         attributes( 0 ),
         paintAttributes( 
             QwtPlotCurve::ClipPolygons | QwtPlotCurve::FilterPoints ),
-        legendAttributes( 0 )
+        legendAttributes( 0 ),
+        colorMap( NULL ),
+        dataRevision( 0 )
     {
         pen = QPen( Qt::black );
         curveFitter = new QwtSplineCurveFitter;
@@ -95,6 +404,7 @@ public:
     {
         delete symbol;
         delete curveFitter;
+        delete colorMap;
     }
 
     QwtPlotCurve::CurveStyle style;
@@ -110,6 +420,17 @@ public:
     QwtPlotCurve::PaintAttributes paintAttributes;
 
     QwtPlotCurve::LegendAttributes legendAttributes;
+
+    QwtColorMap *colorMap;
+
+    uint dataRevision;
+    mutable QwtPlotCurveFitCache fitCache;
+
+    // buffers for the clipped lines, that are reused for each replot
+    mutable QPolygonF clippedPoints;
+    mutable QVector<int> clippedRuns;
+
+    mutable QwtPlotCurveDensityCache densityCache;
 };
 
 /*!
@@ -143,6 +464,7 @@ void QwtPlotCurve::init()
 {
     setItemAttribute( QwtPlotItem::Legend );
     setItemAttribute( QwtPlotItem::AutoScale );
+    setConcurrentRenderingType( typeid( QwtPlotCurve ) );
 
     d_data = new PrivateData;
     setData( new QwtPointSeriesData() );
@@ -169,6 +491,9 @@ void QwtPlotCurve::setPaintAttribute( PaintAttribute attribute, bool on )
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    if ( attribute == CacheFittedCurve && !on )
+        d_data->fitCache.invalidate();
 }
 
 /*!
@@ -375,6 +700,8 @@ void QwtPlotCurve::drawSeries( QPainter *painter,
 
     if ( qwtVerifyRange( numSamples, from, to ) > 0 )
     {
+        addPaintStatistics( to - from + 1, 0 );
+
         painter->save();
         painter->setPen( d_data->pen );
 
@@ -407,7 +734,8 @@ void QwtPlotCurve::drawSeries( QPainter *painter,
   \param canvasRect Contents rectangle of the canvas
   \param from index of the first point to be painted
   \param to index of the last point to be painted
-  \sa draw(), drawDots(), drawLines(), drawSteps(), drawSticks()
+  \sa draw(), drawDots(), drawLines(), drawSteps(), drawSticks(),
+      drawDensity()
 */
 void QwtPlotCurve::drawCurve( QPainter *painter, int style,
     const QwtScaleMap &xMap, const QwtScaleMap &yMap,
@@ -434,6 +762,9 @@ void QwtPlotCurve::drawCurve( QPainter *painter, int style,
         case Dots:
             drawDots( painter, xMap, yMap, canvasRect, from, to );
             break;
+        case Density:
+            drawDensity( painter, xMap, yMap, canvasRect, from, to );
+            break;
         case NoCurve:
         default:
             break;
@@ -522,8 +853,57 @@ void QwtPlotCurve::drawLines( QPainter *painter,
                 clipRect.toAlignedRect(), polyline, false );
         }
 
+        addPaintStatistics( 0, polyline.size() );
         QwtPainter::drawPolyline( painter, polyline );
     }
+    else if ( doFit && ( d_data->paintAttributes & CacheFittedCurve ) 
+        && drawFittedLines( painter, xMap, yMap, canvasRect, clipRect ) )
+    {
+        // the fitted curve has been painted from the cache
+    }
+    else if ( ( d_data->paintAttributes & ClipPolygons ) && !doFill && !doFit )
+    {
+        // mapping and clipping in one pass
+
+        const QwtStreamingClipper::Mode mode =
+            testPaintAttribute( SplitClippedLines )
+                ? QwtStreamingClipper::Polyline
+                : QwtStreamingClipper::OpenPolygon;
+
+        QPolygonF &points = d_data->clippedPoints;
+        QVector<int> &runs = d_data->clippedRuns;
+
+        QwtStreamingClipper clipper( clipRect, mode );
+
+        clipper.begin( &points, &runs );
+        mapper.toClippedPolygonF( xMap, yMap, data(), from, to, clipper );
+        clipper.end();
+
+        addPaintStatistics( 0, points.size() );
+
+        if ( runs.size() <= 1 )
+        {
+            QwtPainter::drawPolyline( painter, points );
+        }
+        else
+        {
+            for ( int i = 0; i < runs.size(); i++ )
+            {
+                const int index = runs[i];
+                const int numPoints = ( ( i < runs.size() - 1 )
+                    ? runs[i + 1] : points.size() ) - index;
+
+                QwtPainter::drawPolyline( painter,
+                    points.constData() + index, numPoints );
+            }
+        }
+
+        if ( testPaintAttribute( MinimizeMemory ) )
+        {
+            points = QPolygonF();
+            runs = QVector<int>();
+        }
+    }
     else
     {
         QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
@@ -551,10 +931,12 @@ void QwtPlotCurve::drawLines( QPainter *painter,
                 if ( d_data->paintAttributes & ClipPolygons )
                     polyline = QwtClipper::clipPolygonF( clipRect, polyline, false );
 
+                addPaintStatistics( 0, polyline.size() );
                 QwtPainter::drawPolyline( painter, polyline );
             }
             else
             {
+                addPaintStatistics( 0, polyline.size() );
                 fillCurve( painter, xMap, yMap, canvasRect, polyline );
             }
         }
@@ -573,22 +955,107 @@ void QwtPlotCurve::drawLines( QPainter *painter,
                     const QPainterPath curvePath = 
                         d_data->curveFitter->fitCurvePath( polyline );
 
+                    addPaintStatistics( 0, curvePath.elementCount() );
                     painter->drawPath( curvePath );
                 }
                 else
                 {
                     polyline = d_data->curveFitter->fitCurve( polyline );
+
+                    addPaintStatistics( 0, polyline.size() );
                     QwtPainter::drawPolyline( painter, polyline );
                 }
             }
             else
             {
+                addPaintStatistics( 0, polyline.size() );
                 QwtPainter::drawPolyline( painter, polyline );
             }
         }
     }
 }
 
+/*!
+  \brief Draw the fitted curve from the cache
+
+  The curve fitter runs on the samples in plot coordinates and
+  the result is cached. Only the scale maps are applied.
+
+  \param painter Painter
+  \param xMap x map
+  \param yMap y map
+  \param canvasRect Contents rectangle of the canvas
+  \param clipRect Clip rectangle for the curve lines
+
+  \return false, when the maps are not linear
+  \sa drawLines(), CacheFittedCurve
+*/
+bool QwtPlotCurve::drawFittedLines( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, const QRectF &clipRect ) const
+{
+    if ( !qwtIsLinear( xMap ) || !qwtIsLinear( yMap ) )
+        return false;
+
+    const bool doFill = ( d_data->brush.style() != Qt::NoBrush )
+            && ( d_data->brush.color().alpha() > 0 );
+
+    const bool fitPath = !doFill && 
+        ( d_data->curveFitter->mode() == QwtCurveFitter::Path );
+
+    QwtPlotCurveFitCache &cache = d_data->fitCache;
+    cache.update( data(), d_data->dataRevision, d_data->curveFitter, fitPath );
+
+    const double sx = ( xMap.p2() - xMap.p1() ) / ( xMap.s2() - xMap.s1() );
+    const double sy = ( yMap.p2() - yMap.p1() ) / ( yMap.s2() - yMap.s1() );
+
+    const QTransform transform( sx, 0.0, 0.0, sy, 
+        xMap.p1() - xMap.s1() * sx, yMap.p1() - yMap.s1() * sy );
+
+    if ( fitPath )
+    {
+        const QPainterPath curvePath = transform.map( cache.path );
+
+        addPaintStatistics( 0, curvePath.elementCount() );
+        painter->drawPath( curvePath );
+
+        return true;
+    }
+
+    QPolygonF polyline = transform.map( cache.polygon );
+
+    if ( doFill )
+    {
+        if ( painter->pen().style() != Qt::NoPen )
+        {
+            QPolygonF filled = polyline;
+            fillCurve( painter, xMap, yMap, canvasRect, filled );
+            filled.clear();
+
+            if ( d_data->paintAttributes & ClipPolygons )
+                polyline = QwtClipper::clipPolygonF( clipRect, polyline, false );
+
+            addPaintStatistics( 0, polyline.size() );
+            QwtPainter::drawPolyline( painter, polyline );
+        }
+        else
+        {
+            addPaintStatistics( 0, polyline.size() );
+            fillCurve( painter, xMap, yMap, canvasRect, polyline );
+        }
+    }
+    else
+    {
+        if ( d_data->paintAttributes & ClipPolygons )
+            polyline = QwtClipper::clipPolygonF( clipRect, polyline, false );
+
+        addPaintStatistics( 0, polyline.size() );
+        QwtPainter::drawPolyline( painter, polyline );
+    }
+
+    return true;
+}
+
 /*!
   Draw sticks
 
@@ -639,6 +1106,8 @@ void QwtPlotCurve::drawSticks( QPainter *painter,
             QwtPainter::drawLine( painter, xi, y0, xi, yi );
     }
 
+    addPaintStatistics( 0, 2 * ( to - from + 1 ) );
+
     painter->restore();
 }
 
@@ -689,6 +1158,8 @@ void QwtPlotCurve::drawDots( QPainter *painter,
         QPolygonF points = mapper.toPointsF( 
             xMap, yMap, data(), from, to );
 
+        addPaintStatistics( 0, points.size() );
+
         QwtPainter::drawPoints( painter, points );
         fillCurve( painter, xMap, yMap, canvasRect, points );
     }
@@ -720,6 +1191,8 @@ void QwtPlotCurve::drawDots( QPainter *painter,
 
             QwtPainter::drawPoint( painter, QPointF( xi, yi ) );
         }
+
+        addPaintStatistics( 0, to - from + 1 );
     }
     else
     {
@@ -728,6 +1201,7 @@ void QwtPlotCurve::drawDots( QPainter *painter,
             const QPolygon points = mapper.toPoints(
                 xMap, yMap, data(), from, to ); 
 
+            addPaintStatistics( 0, points.size() );
             QwtPainter::drawPoints( painter, points );
         }
         else
@@ -735,6 +1209,7 @@ void QwtPlotCurve::drawDots( QPainter *painter,
             const QPolygonF points = mapper.toPointsF( 
                 xMap, yMap, data(), from, to );
 
+            addPaintStatistics( 0, points.size() );
             QwtPainter::drawPoints( painter, points );
         }
     }
@@ -810,10 +1285,12 @@ void QwtPlotCurve::drawSteps( QPainter *painter,
         const QPolygonF clipped = QwtClipper::clipPolygonF( 
             clipRect, polygon, false );
 
+        addPaintStatistics( 0, clipped.size() );
         QwtPainter::drawPolyline( painter, clipped );
     }
     else
     {
+        addPaintStatistics( 0, polygon.size() );
         QwtPainter::drawPolyline( painter, polygon );
     }
 
@@ -821,6 +1298,159 @@ void QwtPlotCurve::drawSteps( QPainter *painter,
         fillCurve( painter, xMap, yMap, canvasRect, polygon );
 }
 
+/*!
+  Draw the density of the points
+
+  The points are counted per pixel of the canvas. The counts are
+  mapped to colors of the colorMap() and displayed as an image.
+
+  \param painter Painter
+  \param xMap x map
+  \param yMap y map
+  \param canvasRect Contents rectangle of the canvas
+  \param from index of the first point to be painted
+  \param to index of the last point to be painted
+
+  \sa Density, LogDensity, setColorMap(),
+      draw(), drawCurve(), drawDots(), drawLines(), drawSteps()
+*/
+void QwtPlotCurve::drawDensity( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to ) const
+{
+    const QRect rect = canvasRect.toAlignedRect();
+    if ( rect.isEmpty() || from > to )
+        return;
+
+    QwtPlotCurveDensityCache &cache = d_data->densityCache;
+
+    if ( !cache.isValid( data(), d_data->dataRevision,
+        xMap, yMap, rect, from, to ) )
+    {
+        cache.invalidate();
+
+        const int numPixels = rect.width() * rect.height();
+
+        QVector<quint32> counts( numPixels, 0 );
+
+        QwtDensityCommand command;
+        command.series = data();
+
+#if !defined(QT_NO_QFUTURE)
+        uint numThreads = renderThreadCount();
+
+        if ( numThreads <= 0 )
+            numThreads = QThread::idealThreadCount();
+
+        if ( numThreads <= 0 )
+            numThreads = 1;
+
+        if ( static_cast<int>( numThreads ) > to - from + 1 )
+            numThreads = to - from + 1;
+
+        // each thread counts into its own buffer
+
+        QVector< QVector<quint32> > buffers( numThreads - 1 );
+        for ( int i = 0; i < buffers.size(); i++ )
+            buffers[i].fill( 0, numPixels );
+
+        const int numPoints = ( to - from + 1 ) / numThreads;
+
+        QList< QFuture<void> > futures;
+        for ( uint i = 0; i < numThreads; i++ )
+        {
+            const int index0 = from + i * numPoints;
+            if ( i == numThreads - 1 )
+            {
+                command.from = index0;
+                command.to = to;
+
+                qwtCountPoints( xMap, yMap, command, rect, counts.data() );
+            }
+            else
+            {
+                command.from = index0;
+                command.to = index0 + numPoints - 1;
+
+                futures += QtConcurrent::run( &qwtCountPoints,
+                    xMap, yMap, command, rect, buffers[i].data() );
+            }
+        }
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+
+        quint32 *c = counts.data();
+        for ( int i = 0; i < buffers.size(); i++ )
+        {
+            const quint32 *b = buffers[i].constData();
+            for ( int j = 0; j < numPixels; j++ )
+                c[j] += b[j];
+        }
+#else
+        command.from = from;
+        command.to = to;
+
+        qwtCountPoints( xMap, yMap, command, rect, counts.data() );
+#endif
+
+        cache.series = data();
+        cache.dataRevision = d_data->dataRevision;
+        cache.numSamples = dataSize();
+        cache.from = from;
+        cache.to = to;
+        cache.xMap = xMap;
+        cache.yMap = yMap;
+        cache.rect = rect;
+        cache.counts = counts;
+
+        addPaintStatistics( to - from + 1, numPixels );
+    }
+
+    const quint32 *counts = cache.counts.constData();
+    const int numPixels = cache.counts.size();
+
+    quint32 maxCount = 0;
+    for ( int i = 0; i < numPixels; i++ )
+        maxCount = qMax( maxCount, counts[i] );
+
+    if ( maxCount == 0 )
+        return;
+
+    const bool logDensity = d_data->attributes & LogDensity;
+
+    const QwtInterval interval( 0.0,
+        logDensity ? qLn( 1.0 + maxCount ) : double( maxCount ) );
+
+    QwtAlphaColorMap defaultColorMap( d_data->pen.color() );
+
+    const QwtColorMap *colorMap = d_data->colorMap;
+    if ( colorMap == NULL )
+        colorMap = &defaultColorMap;
+
+    const QVector<QRgb> colorTable = colorMap->colorTable256();
+
+    QImage image( rect.size(), QImage::Format_ARGB32 );
+
+    QRgb *bits = reinterpret_cast<QRgb *>( image.bits() );
+    for ( int i = 0; i < numPixels; i++ )
+    {
+        const quint32 count = counts[i];
+        if ( count == 0 )
+        {
+            bits[i] = 0u;
+        }
+        else
+        {
+            const double value = logDensity ? qLn( 1.0 + count ) : count;
+
+            const uint index = colorMap->colorIndex( 256, interval, value );
+            bits[i] = colorTable[index];
+        }
+    }
+
+    painter->drawImage( rect, image );
+}
+
 
 /*!
   Specify an attribute for drawing the curve
@@ -874,6 +1504,8 @@ void QwtPlotCurve::setCurveFitter( QwtCurveFitter *curveFitter )
     delete d_data->curveFitter;
     d_data->curveFitter = curveFitter;
 
+    d_data->fitCache.invalidate();
+
     itemChanged();
 }
 
@@ -888,6 +1520,53 @@ QwtCurveFitter *QwtPlotCurve::curveFitter() const
     return d_data->curveFitter;
 }
 
+/*!
+  \brief Assign a color map for the Density style
+
+  The counts of points per pixel are mapped to the colors
+  of the color map, where the interval of the color map goes from 0
+  to the maximum count. Pixels without any point are left transparent.
+
+  When no color map is assigned, a QwtAlphaColorMap
+  with the color of the pen() is used.
+
+  \param colorMap Color map
+  \sa colorMap(), Density, LogDensity
+  \note The curve takes the ownership of the color map
+*/
+void QwtPlotCurve::setColorMap( QwtColorMap *colorMap )
+{
+    if ( colorMap != d_data->colorMap )
+    {
+        delete d_data->colorMap;
+        d_data->colorMap = colorMap;
+
+        legendChanged();
+        itemChanged();
+    }
+}
+
+/*!
+  \return Color map for the Density style
+  \sa setColorMap()
+*/
+const QwtColorMap *QwtPlotCurve::colorMap() const
+{
+    return d_data->colorMap;
+}
+
+/*!
+  \brief Invalidate the cached fitted curve and call itemChanged()
+  \sa CacheFittedCurve
+ */
+void QwtPlotCurve::dataChanged()
+{
+    d_data->dataRevision++;
+    d_data->densityCache.invalidate();
+
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
   Fill the area between the curve and the baseline with
   the curve brush
@@ -1013,7 +1692,10 @@ void QwtPlotCurve::drawSymbols( QPainter *painter, const QwtSymbol &symbol,
             data(), i, i + n - 1 );
 
         if ( points.size() > 0 )
+        {
+            addPaintStatistics( 0, points.size() );
             symbol.drawSymbols( painter, points );
+        }
     }
 }
 
@@ -1097,6 +1779,57 @@ int QwtPlotCurve::closestPoint( const QPoint &pos, double *dist ) const
     return index;
 }
 
+/*!
+   \brief Calculate the area on the canvas, that is painted by the curve
+
+   The area is the bounding rectangle of the samples translated into
+   paint coordinates and extended by the pen width and the size of the
+   symbol. For curves, that are filled, fitted or painted in 
+   Sticks or user defined styles the complete canvasRect is returned.
+
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+
+   \return Bounding rectangle of the painted area
+   \sa QwtPlotItem::paintBoundingRect(), boundingRect()
+ */
+QRectF QwtPlotCurve::paintBoundingRect( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QRectF &canvasRect ) const
+{
+    if ( dataSize() <= 0 )
+        return QRectF();
+
+    if ( d_data->brush.style() != Qt::NoBrush 
+        || ( d_data->attributes & Fitted )
+        || ( d_data->style == Sticks ) || ( d_data->style >= UserCurve ) )
+    {
+        return canvasRect;
+    }
+
+    const QRectF br = boundingRect();
+    if ( br.width() < 0.0 || br.height() < 0.0 )
+        return canvasRect;
+
+    QRectF rect = QwtScaleMap::transform( xMap, yMap, br );
+    if ( !qIsFinite( rect.width() ) || !qIsFinite( rect.height() ) )
+        return canvasRect;
+
+    qreal off = qMax( d_data->pen.widthF(), qreal( 1.0 ) );
+
+    if ( d_data->symbol && 
+        ( d_data->symbol->style() != QwtSymbol::NoSymbol ) )
+    {
+        const QRect symbolRect = d_data->symbol->boundingRect();
+        off = qMax( off, qreal( qMax( 
+            qAbs( symbolRect.left() ), qAbs( symbolRect.right() ) ) ) );
+        off = qMax( off, qreal( qMax( 
+            qAbs( symbolRect.top() ), qAbs( symbolRect.bottom() ) ) ) );
+    }
+
+    return rect.adjusted( -off, -off, off, off );
+}
+
 /*!
    \return Icon representing the curve on the legend
 
@@ -1174,6 +1907,41 @@ QwtGraphic QwtPlotCurve::legendIcon( int index,
     return graphic;
 }
 
+/*!
+   \return Key including all attributes, that have an effect on legendIcon()
+
+   \param index Index of the legend entry
+                ( ignored as there is only one )
+   \param size Icon size
+
+   \note For derived classes an empty key is returned, as they might
+         reimplement legendIcon(). Then legendIconKey() needs to be
+         reimplemented too, to enable caching of the icon.
+
+   \sa QwtPlotItem::legendIconKey(), QwtPlotItem::legendData()
+ */
+QByteArray QwtPlotCurve::legendIconKey( int index,
+    const QSizeF &size ) const
+{
+    Q_UNUSED( index );
+
+    if ( size.isEmpty() || typeid( *this ) != typeid( QwtPlotCurve ) )
+        return QByteArray();
+
+    QByteArray key;
+
+    QDataStream stream( &key, QIODevice::WriteOnly );
+    stream << rtti() << size << int( d_data->legendAttributes )
+        << testRenderHint( QwtPlotItem::RenderAntialiased )
+        << ( style() != QwtPlotCurve::NoCurve )
+        << d_data->brush << pen();
+
+    if ( !qwtAppendSymbolKey( stream, d_data->symbol ) )
+        return QByteArray();
+
+    return key;
+}
+
 /*!
   Initialize data with an array of points.
 
@@ -22,6 +22,7 @@ class QPolygonF;
 class QwtScaleMap;
 class QwtSymbol;
 class QwtCurveFitter;
+class QwtColorMap;
 
 /*!
   \brief A plot item, that represents a series of points
@@ -95,6 +96,20 @@ public:
         */
         Dots,
 
+        /*!
+           Count the points, that are mapped to each pixel of the canvas,
+           and display the counts as an image, where the colors are
+           taken from colorMap(). Points outside of the canvas are ignored.
+
+           Unlike Dots, where huge scatter plots often end up in a solid
+           blob, the distribution of the points remains visible.
+           The counts are calculated in renderThreadCount() threads and
+           cached until the data or the scale maps change.
+
+           \sa setColorMap(), LogDensity
+         */
+        Density,
+
         /*!
            Styles >= QwtPlotCurve::UserCurve are reserved for derived
            classes of QwtPlotCurve that overload drawCurve() with
@@ -125,7 +140,15 @@ public:
           If painting in QwtPlotCurve::Fitted mode is slow it might be better
           to fit the points, before they are passed to QwtPlotCurve.
          */
-        Fitted = 0x02
+        Fitted = 0x02,
+
+        /*!
+           For QwtPlotCurve::Density only.
+           Map the logarithm of the counts to the colors instead of
+           the counts itself, what makes low densities better visible
+           in case of a few hot spots.
+         */
+        LogDensity = 0x04
     };
 
     //! Curve attributes
@@ -228,6 +251,57 @@ public:
                 that is worked around in QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+          Cache the result of the curve fitter.
+
+          Usually the curve fitter operates on the translated points
+          and has to be executed for each replot. When CacheFittedCurve
+          is enabled the fitter runs on the samples in plot coordinates and
+          the result is cached, until the data or the configuration of the
+          fitter ( see QwtCurveFitter::invalidate() ) changes. For each replot
+          only the scale maps are applied to the cached geometry.
+
+          The samples are fitted in segments of 1024 samples, so that
+          only the segments at the end of the series need to be refitted,
+          when samples have been appended to the data object. As each
+          segment is fitted independently the result is not exactly the
+          same as fitting all samples at once: f.e. the slopes of a spline
+          are not continuous at the joins of the segments.
+
+          The cache is valid until the data has been reassigned
+          ( setSamples(), setRawSamples(), setData() ). Appending samples
+          is detected by the size of the data object, but any other
+          modification in place - f.e. of the buffers passed to
+          setRawSamples() - is not noticed and requires to assign
+          the data again.
+
+          \note Implemented for QwtPlotCurve::Lines with the Fitted
+                 CurveAttribute only
+          \note As the fitter operates in plot coordinates, parameters like
+                 QwtWeedingCurveFitter::tolerance() are in plot coordinates too
+          \note Fitting in plot coordinates results in a different shape
+                 than fitting in paint device coordinates, when the scales
+                 of the x and y axes have different ratios. F.e. a spline
+                 doesn't keep its shape, when only one axis is zoomed.
+          \note For non linear scales ( f.e. logarithmic ) this attribute
+                 is ignored.
+         */
+        CacheFittedCurve = 0x20,
+
+        /*!
+          Split the clipped lines into runs of visible lines, instead
+          of connecting them along the border of the clip rectangle.
+          Each run is painted by a separate QwtPainter::drawPolyline().
+
+          This avoids painting the lines along the border, but dash
+          patterns restart and the joins are lost at the beginning of
+          each run, and vector formats get one path per run.
+
+          \note Has only an effect, when ClipPolygons is enabled
+          \note Implemented for unfitted and unfilled QwtPlotCurve::Lines only
+         */
+        SplitClippedLines = 0x40
     };
 
     //! Paint attributes
@@ -283,11 +357,18 @@ public:
     void setCurveFitter( QwtCurveFitter * );
     QwtCurveFitter *curveFitter() const;
 
+    void setColorMap( QwtColorMap * );
+    const QwtColorMap *colorMap() const;
+
     virtual void drawSeries( QPainter *,
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect, int from, int to ) const;
 
+    virtual QRectF paintBoundingRect( const QwtScaleMap &,
+        const QwtScaleMap &, const QRectF &canvasRect ) const;
+
     virtual QwtGraphic legendIcon( int index, const QSizeF & ) const;
+    virtual QByteArray legendIconKey( int index, const QSizeF & ) const;
 
 protected:
 
@@ -317,6 +398,10 @@ protected:
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect, int from, int to ) const;
 
+    virtual void drawDensity( QPainter *p,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to ) const;
+
     virtual void fillCurve( QPainter *,
         const QwtScaleMap &, const QwtScaleMap &, 
         const QRectF &canvasRect, QPolygonF & ) const;
@@ -324,7 +409,13 @@ protected:
     void closePolyline( QPainter *,
         const QwtScaleMap &, const QwtScaleMap &, QPolygonF & ) const;
 
+    virtual void dataChanged();
+
 private:
+    bool drawFittedLines( QPainter *, 
+        const QwtScaleMap &, const QwtScaleMap &,
+        const QRectF &canvasRect, const QRectF &clipRect ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
@@ -0,0 +1,140 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_FRAME_RECORD_H
+#define QWT_PLOT_FRAME_RECORD_H 1
+
+#include "qwt_global.h"
+#include <qstring.h>
+#include <qvector.h>
+#include <qmetatype.h>
+
+class QwtPlotItem;
+
+/*!
+  \brief Timing and sample counts of a plot item painted in a frame
+
+  \sa QwtPlotFrameRecord, QwtPlotItem::getPaintStatistics()
+ */
+class QWT_EXPORT QwtPlotItemRecord
+{
+public:
+    QwtPlotItemRecord();
+
+    /*!
+      Plot item. As the item might have been deleted meanwhile
+      the pointer is intended for identification only.
+     */
+    const QwtPlotItem *item;
+
+    //! QwtPlotItem::rtti() of the item
+    int rtti;
+
+    //! Title of the item
+    QString title;
+
+    //! Time ( in ms ) spent in QwtPlotItem::draw()
+    double drawTime;
+
+    //! Number of samples passed to the paint routines of the item
+    size_t numSamples;
+
+    //! Number of points passed to the painter after filtering and clipping
+    size_t numPoints;
+};
+
+/*!
+  Constructor
+  All values are initialized by 0
+*/
+inline QwtPlotItemRecord::QwtPlotItemRecord():
+    item( NULL ),
+    rtti( 0 ),
+    drawTime( 0.0 ),
+    numSamples( 0 ),
+    numPoints( 0 )
+{
+}
+
+/*!
+  \brief Timings of a replot cycle of a QwtPlot
+
+  A frame starts with QwtPlot::replot() and ends, when
+  the canvas has been painted. All times are in ms.
+
+  \sa QwtPlot::RecordFrames, QwtPlot::frameRecords(),
+      QwtPlot::frameRecorded()
+ */
+class QWT_EXPORT QwtPlotFrameRecord
+{
+public:
+    QwtPlotFrameRecord();
+
+    double itemsTime() const;
+
+    //! Sequence number of the frame
+    uint frame;
+
+    //! Time spent in QwtPlot::updateAxes()
+    double updateAxesTime;
+
+    //! Time spent in QwtPlot::updateLayout()
+    double layoutTime;
+
+    //! Number of calls of QwtPlot::updateLayout()
+    uint numLayouts;
+
+    /*!
+      Number of layouts, that have been taken from the cache
+      \sa QwtPlotLayout::isActivatedFromCache()
+     */
+    uint numCachedLayouts;
+
+    //! Time spent for updating the legend
+    double legendTime;
+
+    //! Time spent for painting the scale widgets
+    double scaleTime;
+
+    //! Time spent in QwtPlot::drawCanvas()
+    double canvasTime;
+
+    //! Records of all items, that have been painted on the canvas
+    QVector<QwtPlotItemRecord> items;
+};
+
+/*!
+  Constructor
+  All values are initialized by 0
+*/
+inline QwtPlotFrameRecord::QwtPlotFrameRecord():
+    frame( 0 ),
+    updateAxesTime( 0.0 ),
+    layoutTime( 0.0 ),
+    numLayouts( 0 ),
+    numCachedLayouts( 0 ),
+    legendTime( 0.0 ),
+    scaleTime( 0.0 ),
+    canvasTime( 0.0 )
+{
+}
+
+//! \return Accumulated draw time of all items
+inline double QwtPlotFrameRecord::itemsTime() const
+{
+    double t = 0.0;
+    for ( int i = 0; i < items.size(); i++ )
+        t += items[i].drawTime;
+
+    return t;
+}
+
+Q_DECLARE_METATYPE( QwtPlotFrameRecord )
+
+#endif
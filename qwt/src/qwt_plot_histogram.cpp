@@ -14,6 +14,9 @@
 #include "qwt_scale_map.h"
 #include <qstring.h>
 #include <qpainter.h>
+#include <qmath.h>
+#include <qdatastream.h>
+#include <typeinfo>
 
 static inline bool qwtIsCombinable( const QwtInterval &d1,
     const QwtInterval &d2 )
@@ -39,7 +42,8 @@ public:
     PrivateData():
         baseline( 0.0 ),
         style( Columns ),
-        symbol( NULL )
+        symbol( NULL ),
+        paintAttributes( 0 )
     {
     }
 
@@ -54,6 +58,8 @@ public:
     QBrush brush;
     QwtPlotHistogram::HistogramStyle style;
     const QwtColumnSymbol *symbol;
+
+    QwtPlotHistogram::PaintAttributes paintAttributes;
 };
 
 /*!
@@ -90,10 +96,37 @@ void QwtPlotHistogram::init()
 
     setItemAttribute( QwtPlotItem::AutoScale, true );
     setItemAttribute( QwtPlotItem::Legend, true );
+    setConcurrentRenderingType( typeid( QwtPlotHistogram ) );
 
     setZ( 20.0 );
 }
 
+/*!
+  Specify an attribute how to draw the histogram
+
+  \param attribute Paint attribute
+  \param on On/Off
+  \sa testPaintAttribute()
+*/
+void QwtPlotHistogram::setPaintAttribute(
+    PaintAttribute attribute, bool on )
+{
+    if ( on )
+        d_data->paintAttributes |= attribute;
+    else
+        d_data->paintAttributes &= ~attribute;
+}
+
+/*!
+    \return True, when attribute is enabled
+    \sa PaintAttribute, setPaintAttribute()
+*/
+bool QwtPlotHistogram::testPaintAttribute(
+    PaintAttribute attribute ) const
+{
+    return ( d_data->paintAttributes & attribute );
+}
+
 /*!
   Set the histogram's drawing style
 
@@ -462,6 +495,13 @@ void QwtPlotHistogram::drawColumns( QPainter *painter,
     painter->setPen( d_data->pen );
     painter->setBrush( d_data->brush );
 
+    if ( ( d_data->paintAttributes & MergeColumns ) && ( d_data->symbol == NULL 
+        || d_data->symbol->style() == QwtColumnSymbol::NoStyle ) )
+    {
+        drawMergedColumns( painter, xMap, yMap, from, to );
+        return;
+    }
+
     const QwtSeriesData<QwtIntervalSample> *series = data();
 
     for ( int i = from; i <= to; i++ )
@@ -475,6 +515,55 @@ void QwtPlotHistogram::drawColumns( QPainter *painter,
     }
 }
 
+/*!
+  Draw the columns as plain rectangles in one batch
+
+  \param painter Painter
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param from Index of the first sample to be painted
+  \param to Index of the last sample to be painted
+
+  \sa MergeColumns, drawColumns()
+*/
+void QwtPlotHistogram::drawMergedColumns( QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    int from, int to ) const
+{
+    const bool doAlign = QwtPainter::roundingAlignment( painter );
+
+    const QwtSeriesData<QwtIntervalSample> *series = data();
+
+    QVector<QRectF> rects;
+    rects.reserve( doAlign ? qMin( to - from + 1, 4096 ) : to - from + 1 );
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtIntervalSample sample = series->sample( i );
+        if ( sample.interval.isNull() || !sample.interval.isValid() )
+            continue;
+
+        QRectF r = columnRect( sample, xMap, yMap ).toRect();
+
+        if ( doAlign )
+        {
+            r.setLeft( qRound( r.left() ) );
+            r.setRight( qRound( r.right() ) );
+            r.setTop( qRound( r.top() ) );
+            r.setBottom( qRound( r.bottom() ) );
+
+            QwtPainter::addColumnRect( rects, r, orientation() );
+        }
+        else
+        {
+            rects += r;
+        }
+    }
+
+    addPaintStatistics( to - from + 1, rects.size() );
+    QwtPainter::drawRects( painter, rects.constData(), rects.size() );
+}
+
 /*!
   Draw a histogram in Lines style()
 
@@ -688,3 +777,30 @@ QwtGraphic QwtPlotHistogram::legendIcon( int index,
     Q_UNUSED( index );
     return defaultIcon( d_data->brush, size );
 }
+
+/*!
+  \return Key including all attributes, that have an effect on legendIcon()
+
+  \param index Index of the legend entry
+                ( ignored as there is only one )
+  \param size Icon size
+
+  \note For derived classes an empty key is returned, as they might
+        reimplement legendIcon()
+  \sa QwtPlotItem::legendIconKey(), QwtPlotItem::legendData()
+*/
+QByteArray QwtPlotHistogram::legendIconKey( int index,
+    const QSizeF &size ) const
+{
+    Q_UNUSED( index );
+
+    if ( size.isEmpty() || typeid( *this ) != typeid( QwtPlotHistogram ) )
+        return QByteArray();
+
+    QByteArray key;
+
+    QDataStream stream( &key, QIODevice::WriteOnly );
+    stream << rtti() << size << d_data->brush;
+
+    return key;
+}
@@ -76,12 +76,42 @@ public:
         UserStyle = 100
     };
 
+    /*!
+        Attributes to modify the drawing algorithm.
+        \sa setPaintAttribute(), testPaintAttribute()
+    */
+    enum PaintAttribute
+    {
+        /*!
+          Draw all columns in Columns style with one call of
+          QwtPainter::drawRects(). When drawing to a paint device 
+          in integer coordinates ( f.e. all widgets on screen )
+          consecutive columns, that are not wider than a pixel and are
+          mapped to the same pixel column are merged into one rectangle,
+          that covers the minimum and the maximum of their values.
+
+          For histograms with many more intervals than pixels the
+          number of rectangles to be painted is limited by the 
+          size of the plot canvas.
+
+          \note The merged columns are painted without calling drawColumn()
+          \note Only applicable, when no symbol() has been set
+         */
+        MergeColumns = 0x01
+    };
+
+    //! Paint attributes
+    typedef QFlags<PaintAttribute> PaintAttributes;
+
     explicit QwtPlotHistogram( const QString &title = QString::null );
     explicit QwtPlotHistogram( const QwtText &title );
     virtual ~QwtPlotHistogram();
 
     virtual int rtti() const;
 
+    void setPaintAttribute( PaintAttribute, bool on = true );
+    bool testPaintAttribute( PaintAttribute ) const;
+
     void setPen( const QColor &, qreal width = 0.0, Qt::PenStyle = Qt::SolidLine );
     void setPen( const QPen & );
     const QPen &pen() const;
@@ -108,6 +138,7 @@ public:
     virtual QRectF boundingRect() const;
 
     virtual QwtGraphic legendIcon( int index, const QSizeF & ) const;
+    virtual QByteArray legendIconKey( int index, const QSizeF & ) const;
 
 protected:
     virtual QwtColumnRect columnRect( const QwtIntervalSample &,
@@ -132,8 +163,14 @@ private:
     void init();
     void flushPolygon( QPainter *, double baseLine, QPolygonF & ) const;
 
+    void drawMergedColumns( QPainter *,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        int from, int to ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS( QwtPlotHistogram::PaintAttributes )
+
 #endif
@@ -0,0 +1,819 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_image_renderer.h"
+#include "qwt_plot.h"
+#include "qwt_plot_item.h"
+#include "qwt_painter.h"
+#include "qwt_scale_draw.h"
+#include "qwt_scale_engine.h"
+#include "qwt_scale_div.h"
+#include "qwt_scale_map.h"
+#include "qwt_interval.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include <qpainter.h>
+#include <qpalette.h>
+#include <qfont.h>
+#include <qbrush.h>
+#include <qalgorithms.h>
+
+static inline bool qwtIsVertical( int axisId )
+{
+    return axisId == QwtPlot::yLeft || axisId == QwtPlot::yRight;
+}
+
+static bool qwtLessZThan( const QwtPlotItem *item1, const QwtPlotItem *item2 )
+{
+    return item1->z() < item2->z();
+}
+
+class QwtPlotImageRenderer::PrivateData
+{
+public:
+    class AxisData
+    {
+    public:
+        AxisData():
+            isEnabled( false ),
+            doAutoScale( true ),
+            maxMajor( 8 ),
+            maxMinor( 5 ),
+            scaleEngine( new QwtLinearScaleEngine() ),
+            scaleDraw( new QwtScaleDraw() )
+        {
+        }
+
+        ~AxisData()
+        {
+            delete scaleEngine;
+            delete scaleDraw;
+        }
+
+        bool isEnabled;
+        bool doAutoScale;
+
+        int maxMajor;
+        int maxMinor;
+
+        QwtText title;
+
+        QwtScaleDiv scaleDiv;
+        QwtScaleEngine *scaleEngine;
+        QwtScaleDraw *scaleDraw;
+    };
+
+    PrivateData():
+        background( Qt::white ),
+        canvasBackground( Qt::white ),
+        spacing( 5 )
+    {
+        axisData[QwtPlot::yLeft].isEnabled = true;
+        axisData[QwtPlot::xBottom].isEnabled = true;
+
+        axisData[QwtPlot::yLeft].scaleDraw->setAlignment(
+            QwtScaleDraw::LeftScale );
+        axisData[QwtPlot::yRight].scaleDraw->setAlignment(
+            QwtScaleDraw::RightScale );
+        axisData[QwtPlot::xBottom].scaleDraw->setAlignment(
+            QwtScaleDraw::BottomScale );
+        axisData[QwtPlot::xTop].scaleDraw->setAlignment(
+            QwtScaleDraw::TopScale );
+    }
+
+    QwtText title;
+    QFont font;
+    QPalette palette;
+
+    QBrush background;
+    QBrush canvasBackground;
+
+    int spacing;
+
+    QwtPlotItemList items;
+
+    AxisData axisData[QwtPlot::axisCnt];
+};
+
+/*!
+  Constructor
+
+  The left and bottom axes are enabled and all scales
+  are calculated from the bounding rectangles of the items.
+ */
+QwtPlotImageRenderer::QwtPlotImageRenderer()
+{
+    // initializing the screen metrics, before rendering
+    // from other threads
+    ( void )QwtPainter::screenDevice();
+
+    d_data = new PrivateData;
+}
+
+//! Destructor
+QwtPlotImageRenderer::~QwtPlotImageRenderer()
+{
+    delete d_data;
+}
+
+/*!
+  Set the title
+
+  \param title Title
+  \sa title()
+ */
+void QwtPlotImageRenderer::setTitle( const QwtText &title )
+{
+    d_data->title = title;
+}
+
+/*!
+  \return Title
+  \sa setTitle()
+ */
+QwtText QwtPlotImageRenderer::title() const
+{
+    return d_data->title;
+}
+
+/*!
+  Set the font for the titles and the tick labels
+
+  \param font Font
+  \sa font()
+ */
+void QwtPlotImageRenderer::setFont( const QFont &font )
+{
+    d_data->font = font;
+}
+
+/*!
+  \return Font for the titles and the tick labels
+  \sa setFont()
+ */
+QFont QwtPlotImageRenderer::font() const
+{
+    return d_data->font;
+}
+
+/*!
+  Set the palette for the titles and the scales
+
+  \param palette Palette
+  \sa palette(), QwtAbstractScaleDraw::draw()
+ */
+void QwtPlotImageRenderer::setPalette( const QPalette &palette )
+{
+    d_data->palette = palette;
+}
+
+/*!
+  \return Palette for the titles and the scales
+  \sa setPalette()
+ */
+QPalette QwtPlotImageRenderer::palette() const
+{
+    return d_data->palette;
+}
+
+/*!
+  Set the brush for filling the background of the plot
+
+  The default setting is Qt::white
+
+  \param brush Background brush
+  \sa background(), setCanvasBackground()
+ */
+void QwtPlotImageRenderer::setBackground( const QBrush &brush )
+{
+    d_data->background = brush;
+}
+
+/*!
+  \return Brush for filling the background of the plot
+  \sa setBackground()
+ */
+QBrush QwtPlotImageRenderer::background() const
+{
+    return d_data->background;
+}
+
+/*!
+  Set the brush for filling the background of the canvas
+
+  The default setting is Qt::white
+
+  \param brush Background brush
+  \sa canvasBackground(), setBackground()
+ */
+void QwtPlotImageRenderer::setCanvasBackground( const QBrush &brush )
+{
+    d_data->canvasBackground = brush;
+}
+
+/*!
+  \return Brush for filling the background of the canvas
+  \sa setCanvasBackground()
+ */
+QBrush QwtPlotImageRenderer::canvasBackground() const
+{
+    return d_data->canvasBackground;
+}
+
+/*!
+  Set the spacing between the components of the plot
+
+  The default setting is 5 pixels.
+
+  \param spacing Spacing
+  \sa spacing()
+ */
+void QwtPlotImageRenderer::setSpacing( int spacing )
+{
+    d_data->spacing = qMax( spacing, 0 );
+}
+
+/*!
+  \return Spacing between the components of the plot
+  \sa setSpacing()
+ */
+int QwtPlotImageRenderer::spacing() const
+{
+    return d_data->spacing;
+}
+
+/*!
+  \brief Enable or disable an axis
+
+  When an axis is disabled its scale is still used for mapping the
+  items attached to it, but it is not displayed.
+
+  \param axisId Axis index
+  \param on On/Off
+
+  \sa axisEnabled(), QwtPlot::enableAxis()
+ */
+void QwtPlotImageRenderer::enableAxis( int axisId, bool on )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        d_data->axisData[axisId].isEnabled = on;
+}
+
+/*!
+  \return \c True, if the axis is enabled
+  \param axisId Axis index
+  \sa enableAxis()
+ */
+bool QwtPlotImageRenderer::axisEnabled( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].isEnabled;
+
+    return false;
+}
+
+/*!
+  Set the title of an axis
+
+  \param axisId Axis index
+  \param title Axis title
+  \sa axisTitle()
+ */
+void QwtPlotImageRenderer::setAxisTitle( int axisId, const QwtText &title )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        d_data->axisData[axisId].title = title;
+}
+
+/*!
+  \return Title of an axis
+  \param axisId Axis index
+  \sa setAxisTitle()
+ */
+QwtText QwtPlotImageRenderer::axisTitle( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].title;
+
+    return QwtText();
+}
+
+/*!
+  \brief Assign a scale division to an axis
+
+  Autoscaling is disabled for the axis.
+
+  \param axisId Axis index
+  \param scaleDiv Scale division
+  \sa setAxisAutoScale(), QwtPlot::setAxisScaleDiv()
+ */
+void QwtPlotImageRenderer::setAxisScaleDiv(
+    int axisId, const QwtScaleDiv &scaleDiv )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        d.scaleDiv = scaleDiv;
+        d.doAutoScale = false;
+    }
+}
+
+/*!
+  \brief Enable autoscaling for an axis
+
+  The scale is calculated from the bounding rectangles
+  of the items attached to the axis.
+
+  \param axisId Axis index
+  \param on On/Off
+  \sa axisAutoScale(), setAxisScaleDiv()
+ */
+void QwtPlotImageRenderer::setAxisAutoScale( int axisId, bool on )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        d_data->axisData[axisId].doAutoScale = on;
+}
+
+/*!
+  \return \c True, if autoscaling is enabled
+  \param axisId Axis index
+  \sa setAxisAutoScale()
+ */
+bool QwtPlotImageRenderer::axisAutoScale( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].doAutoScale;
+
+    return false;
+}
+
+/*!
+  Set the maximum number of major scale intervals for autoscaling
+
+  \param axisId Axis index
+  \param maxMajor Maximum number of major steps
+  \sa axisMaxMajor(), QwtPlot::setAxisMaxMajor()
+ */
+void QwtPlotImageRenderer::setAxisMaxMajor( int axisId, int maxMajor )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        d_data->axisData[axisId].maxMajor = qBound( 1, maxMajor, 10000 );
+}
+
+/*!
+  \return Maximum number of major ticks for autoscaling
+  \param axisId Axis index
+  \sa setAxisMaxMajor()
+ */
+int QwtPlotImageRenderer::axisMaxMajor( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].maxMajor;
+
+    return 0;
+}
+
+/*!
+  Set the maximum number of minor scale intervals for autoscaling
+
+  \param axisId Axis index
+  \param maxMinor Maximum number of minor steps
+  \sa axisMaxMinor(), QwtPlot::setAxisMaxMinor()
+ */
+void QwtPlotImageRenderer::setAxisMaxMinor( int axisId, int maxMinor )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        d_data->axisData[axisId].maxMinor = qBound( 0, maxMinor, 100 );
+}
+
+/*!
+  \return Maximum number of minor ticks for autoscaling
+  \param axisId Axis index
+  \sa setAxisMaxMinor()
+ */
+int QwtPlotImageRenderer::axisMaxMinor( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].maxMinor;
+
+    return 0;
+}
+
+/*!
+  Change the scale engine of an axis
+
+  \param axisId Axis index
+  \param scaleEngine Scale engine, that will be owned by the renderer
+
+  \sa axisScaleEngine(), QwtPlot::setAxisScaleEngine()
+ */
+void QwtPlotImageRenderer::setAxisScaleEngine(
+    int axisId, QwtScaleEngine *scaleEngine )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt && scaleEngine != NULL )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        if ( scaleEngine != d.scaleEngine )
+        {
+            delete d.scaleEngine;
+            d.scaleEngine = scaleEngine;
+        }
+    }
+}
+
+/*!
+  \return Scale engine of an axis
+  \param axisId Axis index
+  \sa setAxisScaleEngine()
+ */
+const QwtScaleEngine *QwtPlotImageRenderer::axisScaleEngine( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].scaleEngine;
+
+    return NULL;
+}
+
+/*!
+  Change the scale draw of an axis
+
+  \param axisId Axis index
+  \param scaleDraw Scale draw, that will be owned by the renderer
+
+  \sa axisScaleDraw(), QwtPlot::setAxisScaleDraw()
+ */
+void QwtPlotImageRenderer::setAxisScaleDraw(
+    int axisId, QwtScaleDraw *scaleDraw )
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt && scaleDraw != NULL )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        if ( scaleDraw != d.scaleDraw )
+        {
+            scaleDraw->setAlignment( d.scaleDraw->alignment() );
+
+            delete d.scaleDraw;
+            d.scaleDraw = scaleDraw;
+        }
+    }
+}
+
+/*!
+  \return Scale draw of an axis
+  \param axisId Axis index
+  \sa setAxisScaleDraw()
+ */
+const QwtScaleDraw *QwtPlotImageRenderer::axisScaleDraw( int axisId ) const
+{
+    if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
+        return d_data->axisData[axisId].scaleDraw;
+
+    return NULL;
+}
+
+/*!
+  \brief Assign the items to be rendered
+
+  The items are not owned by the renderer. They are painted in
+  the order of their z values, like on the canvas of a QwtPlot.
+
+  \param items Plot items
+  \sa items(), QwtPlot::drawItems()
+ */
+void QwtPlotImageRenderer::setItems( const QwtPlotItemList &items )
+{
+    d_data->items = items;
+    qStableSort( d_data->items.begin(), d_data->items.end(), qwtLessZThan );
+}
+
+/*!
+  \return Plot items
+  \sa setItems()
+ */
+QwtPlotItemList QwtPlotImageRenderer::items() const
+{
+    return d_data->items;
+}
+
+/*!
+  \brief Render the plot into an image
+
+  \param size Size of the image
+  \param format Format of the image
+
+  \return Image with the rendered plot
+  \sa render()
+ */
+QImage QwtPlotImageRenderer::toImage(
+    const QSize &size, QImage::Format format )
+{
+    if ( size.isEmpty() )
+        return QImage();
+
+    QImage image( size, format );
+    image.fill( 0u );
+
+    QPainter painter( &image );
+    render( &painter, QRectF( 0.0, 0.0, size.width(), size.height() ) );
+    painter.end();
+
+    return image;
+}
+
+/*!
+  \brief Render the plot into a rectangle
+
+  \param painter Painter
+  \param rect Target rectangle
+
+  \sa toImage(), renderCanvas()
+ */
+void QwtPlotImageRenderer::render( QPainter *painter, const QRectF &rect )
+{
+    if ( painter == NULL || !painter->isActive() || rect.isEmpty() )
+        return;
+
+    updateScales();
+
+    const QFont &font = d_data->font;
+    const double spacing = d_data->spacing;
+
+    // layout
+
+    QRectF r = rect.adjusted( spacing, spacing, -spacing, -spacing );
+
+    QRectF titleRect;
+    if ( !d_data->title.isEmpty() )
+    {
+        const double h = d_data->title.heightForWidth( r.width(), font );
+
+        titleRect = QRectF( r.left(), r.top(), r.width(), h );
+        r.setTop( titleRect.bottom() + spacing );
+    }
+
+    double extent[QwtPlot::axisCnt];
+    double titleExtent[QwtPlot::axisCnt];
+
+    int startDist[QwtPlot::axisCnt];
+    int endDist[QwtPlot::axisCnt];
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        extent[axisId] = titleExtent[axisId] = 0.0;
+        startDist[axisId] = endDist[axisId] = 0;
+
+        const PrivateData::AxisData &d = d_data->axisData[axisId];
+        if ( !d.isEnabled )
+            continue;
+
+        QwtScaleDraw *scaleDraw = d.scaleDraw;
+        scaleDraw->setScaleDiv( d.scaleDiv );
+        scaleDraw->setTransformation( d.scaleEngine->transformation() );
+        scaleDraw->move( r.topLeft() );
+        scaleDraw->setLength(
+            qwtIsVertical( axisId ) ? r.height() : r.width() );
+
+        scaleDraw->getBorderDistHint( font,
+            startDist[axisId], endDist[axisId] );
+
+        extent[axisId] = qCeil( scaleDraw->extent( font ) );
+
+        if ( !d.title.isEmpty() )
+        {
+            titleExtent[axisId] =
+                qCeil( d.title.textSize( font ).height() ) + spacing;
+        }
+    }
+
+    double left = extent[QwtPlot::yLeft] + titleExtent[QwtPlot::yLeft];
+    double right = extent[QwtPlot::yRight] + titleExtent[QwtPlot::yRight];
+    double top = extent[QwtPlot::xTop] + titleExtent[QwtPlot::xTop];
+    double bottom = extent[QwtPlot::xBottom] + titleExtent[QwtPlot::xBottom];
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        if ( qwtIsVertical( axisId ) )
+        {
+            const int dist = qMax( startDist[axisId], endDist[axisId] );
+
+            top = qMax( top, double( dist ) );
+            bottom = qMax( bottom, double( dist ) );
+        }
+        else
+        {
+            left = qMax( left, double( startDist[axisId] ) );
+            right = qMax( right, double( endDist[axisId] ) );
+        }
+    }
+
+    const QRectF canvasRect = r.adjusted( left, top, -right, -bottom );
+    if ( canvasRect.isEmpty() )
+        return;
+
+    // scale maps, like QwtPlot::canvasMap()
+
+    QwtScaleMap maps[QwtPlot::axisCnt];
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        const PrivateData::AxisData &d = d_data->axisData[axisId];
+
+        QwtScaleMap &map = maps[axisId];
+        map.setTransformation( d.scaleEngine->transformation() );
+        map.setScaleInterval( d.scaleDiv.lowerBound(), d.scaleDiv.upperBound() );
+
+        if ( qwtIsVertical( axisId ) )
+            map.setPaintInterval( canvasRect.bottom(), canvasRect.top() );
+        else
+            map.setPaintInterval( canvasRect.left(), canvasRect.right() );
+    }
+
+    // painting
+
+    painter->save();
+
+    painter->fillRect( rect, d_data->background );
+    painter->fillRect( canvasRect, d_data->canvasBackground );
+
+    painter->save();
+    painter->setClipRect( canvasRect );
+    renderCanvas( painter, canvasRect, maps );
+    painter->restore();
+
+    painter->setFont( font );
+    painter->setPen( d_data->palette.color( QPalette::WindowText ) );
+
+    if ( !d_data->title.isEmpty() )
+        d_data->title.draw( painter, titleRect );
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        const PrivateData::AxisData &d = d_data->axisData[axisId];
+        if ( !d.isEnabled )
+            continue;
+
+        QwtScaleDraw *scaleDraw = d.scaleDraw;
+
+        QRectF axisTitleRect;
+        switch( axisId )
+        {
+            case QwtPlot::yLeft:
+            {
+                scaleDraw->move( canvasRect.left(), canvasRect.top() );
+                axisTitleRect = QRectF( r.left(), canvasRect.top(),
+                    titleExtent[axisId], canvasRect.height() );
+                break;
+            }
+            case QwtPlot::yRight:
+            {
+                scaleDraw->move( canvasRect.right(), canvasRect.top() );
+                axisTitleRect = QRectF( r.right() - titleExtent[axisId],
+                    canvasRect.top(), titleExtent[axisId], canvasRect.height() );
+                break;
+            }
+            case QwtPlot::xTop:
+            {
+                scaleDraw->move( canvasRect.left(), canvasRect.top() );
+                axisTitleRect = QRectF( canvasRect.left(), r.top(),
+                    canvasRect.width(), titleExtent[axisId] );
+                break;
+            }
+            default:
+            {
+                scaleDraw->move( canvasRect.left(), canvasRect.bottom() );
+                axisTitleRect = QRectF( canvasRect.left(),
+                    r.bottom() - titleExtent[axisId],
+                    canvasRect.width(), titleExtent[axisId] );
+            }
+        }
+
+        scaleDraw->setLength( qwtIsVertical( axisId )
+            ? canvasRect.height() : canvasRect.width() );
+
+        painter->save();
+        scaleDraw->draw( painter, d_data->palette );
+        painter->restore();
+
+        if ( d.title.isEmpty() )
+            continue;
+
+        painter->save();
+
+        if ( qwtIsVertical( axisId ) )
+        {
+            // titles of vertical axes are rotated
+
+            const double angle = ( axisId == QwtPlot::yLeft ) ? -90.0 : 90.0;
+
+            painter->translate( axisTitleRect.center() );
+            painter->rotate( angle );
+
+            const QSizeF size = axisTitleRect.size();
+
+            axisTitleRect = QRectF( -0.5 * size.height(), -0.5 * size.width(),
+                size.height(), size.width() );
+        }
+
+        d.title.draw( painter, axisTitleRect );
+
+        painter->restore();
+    }
+
+    painter->restore();
+}
+
+/*!
+  \brief Render the items of the canvas
+
+  \param painter Painter
+  \param canvasRect Bounding rectangle of the canvas
+  \param maps Maps, mapping between plot and paint device coordinates
+
+  \sa QwtPlot::drawItems()
+ */
+void QwtPlotImageRenderer::renderCanvas( QPainter *painter,
+    const QRectF &canvasRect, const QwtScaleMap *maps ) const
+{
+    const QwtPlotItemList &items = d_data->items;
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem *item = items[i];
+        if ( item == NULL || !item->isVisible() )
+            continue;
+
+        painter->save();
+
+        painter->setRenderHint( QPainter::Antialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+        painter->setRenderHint( QPainter::HighQualityAntialiasing,
+            item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
+
+        item->draw( painter,
+            maps[item->xAxis()], maps[item->yAxis()], canvasRect );
+
+        painter->restore();
+    }
+}
+
+/*!
+  Calculate the scales of the axes with autoscaling enabled
+  from the bounding rectangles of the items.
+
+  \sa QwtPlot::updateAxes()
+ */
+void QwtPlotImageRenderer::updateScales()
+{
+    QwtInterval intv[QwtPlot::axisCnt];
+
+    const QwtPlotItemList &items = d_data->items;
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        const QwtPlotItem *item = items[i];
+
+        if ( item == NULL || !item->isVisible()
+            || !item->testItemAttribute( QwtPlotItem::AutoScale ) )
+        {
+            continue;
+        }
+
+        const QRectF rect = item->boundingRect();
+
+        if ( rect.width() >= 0.0 )
+            intv[item->xAxis()] |= QwtInterval( rect.left(), rect.right() );
+
+        if ( rect.height() >= 0.0 )
+            intv[item->yAxis()] |= QwtInterval( rect.top(), rect.bottom() );
+    }
+
+    for ( int axisId = 0; axisId < QwtPlot::axisCnt; axisId++ )
+    {
+        PrivateData::AxisData &d = d_data->axisData[axisId];
+        if ( !d.doAutoScale )
+            continue;
+
+        double minValue = 0.0;
+        double maxValue = 1000.0;
+        double stepSize = 0.0;
+
+        if ( intv[axisId].isValid() )
+        {
+            minValue = intv[axisId].minValue();
+            maxValue = intv[axisId].maxValue();
+
+            d.scaleEngine->autoScale( d.maxMajor,
+                minValue, maxValue, stepSize );
+        }
+
+        d.scaleDiv = d.scaleEngine->divideScale(
+            minValue, maxValue, d.maxMajor, d.maxMinor, stepSize );
+    }
+}
@@ -0,0 +1,128 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_IMAGE_RENDERER_H
+#define QWT_PLOT_IMAGE_RENDERER_H
+
+#include "qwt_global.h"
+#include "qwt_plot_dict.h"
+#include <qimage.h>
+
+class QwtText;
+class QwtScaleDiv;
+class QwtScaleDraw;
+class QwtScaleEngine;
+class QwtScaleMap;
+class QPainter;
+class QPalette;
+class QBrush;
+class QFont;
+class QRectF;
+
+/*!
+  \brief Headless renderer for a plot description
+
+  QwtPlotRenderer renders a QwtPlot widget and therefore can be used
+  from the GUI thread only. QwtPlotImageRenderer renders a description
+  of a plot - title, axes and plot items - without using any widget,
+  so that many plots can be rendered concurrently into images
+  from worker threads.
+
+  \code
+    QwtPlotImageRenderer renderer;
+    renderer.setTitle( "Report" );
+    renderer.setAxisTitle( QwtPlot::xBottom, "Time" );
+    renderer.setItems( items );
+
+    const QImage image = renderer.toImage( QSize( 800, 600 ) );
+  \endcode
+
+  The scales are calculated from the bounding rectangles of the items,
+  unless a scale has been assigned by setAxisScaleDiv(). The layout
+  is a simplified version of what is done by QwtPlotLayout.
+
+  \note A renderer and its items must not be used by more than one
+        thread at the same time. Items, that depend on the plot widget
+        ( f.e. QwtPlotLegendItem, QwtPlotScaleItem ) are not supported.
+
+  \note The first QwtPlotImageRenderer has to be created in the GUI thread,
+        where the screen metrics are initialized.
+
+  \sa QwtPlotRenderer, QwtPainter::screenDevice()
+*/
+class QWT_EXPORT QwtPlotImageRenderer
+{
+public:
+    QwtPlotImageRenderer();
+    virtual ~QwtPlotImageRenderer();
+
+    void setTitle( const QwtText & );
+    QwtText title() const;
+
+    void setFont( const QFont & );
+    QFont font() const;
+
+    void setPalette( const QPalette & );
+    QPalette palette() const;
+
+    void setBackground( const QBrush & );
+    QBrush background() const;
+
+    void setCanvasBackground( const QBrush & );
+    QBrush canvasBackground() const;
+
+    void setSpacing( int );
+    int spacing() const;
+
+    void enableAxis( int axisId, bool on = true );
+    bool axisEnabled( int axisId ) const;
+
+    void setAxisTitle( int axisId, const QwtText & );
+    QwtText axisTitle( int axisId ) const;
+
+    void setAxisScaleDiv( int axisId, const QwtScaleDiv & );
+    void setAxisAutoScale( int axisId, bool on = true );
+    bool axisAutoScale( int axisId ) const;
+
+    void setAxisMaxMajor( int axisId, int maxMajor );
+    int axisMaxMajor( int axisId ) const;
+
+    void setAxisMaxMinor( int axisId, int maxMinor );
+    int axisMaxMinor( int axisId ) const;
+
+    void setAxisScaleEngine( int axisId, QwtScaleEngine * );
+    const QwtScaleEngine *axisScaleEngine( int axisId ) const;
+
+    void setAxisScaleDraw( int axisId, QwtScaleDraw * );
+    const QwtScaleDraw *axisScaleDraw( int axisId ) const;
+
+    void setItems( const QwtPlotItemList & );
+    QwtPlotItemList items() const;
+
+    QImage toImage( const QSize &,
+        QImage::Format = QImage::Format_ARGB32_Premultiplied );
+
+    virtual void render( QPainter *, const QRectF & );
+
+protected:
+    virtual void renderCanvas( QPainter *, const QRectF &canvasRect,
+        const QwtScaleMap *maps ) const;
+
+private:
+    // Disabled copy constructor and operator=
+    QwtPlotImageRenderer( const QwtPlotImageRenderer & );
+    QwtPlotImageRenderer &operator=( const QwtPlotImageRenderer & );
+
+    void updateScales();
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
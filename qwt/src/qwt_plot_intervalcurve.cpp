@@ -13,6 +13,7 @@
 #include "qwt_clipper.h"
 #include "qwt_painter.h"
 #include <string.h>
+#include <typeinfo>
 
 #include <qpainter.h>
 
@@ -42,6 +43,133 @@ static inline bool qwtIsVSampleInside( const QwtIntervalSample &sample,
     return !isOffScreen;
 }
 
+class QwtIntervalQuadrupel
+{
+public:
+    inline void start( double pos, double value )
+    {
+        p0 = pos;
+        v1 = vMin = vMax = v2 = value;
+    }
+
+    inline bool append( double pos, double value )
+    {
+        if ( p0 != pos )
+            return false;
+
+        if ( value < vMin )
+            vMin = value;
+        else if ( value > vMax )
+            vMax = value;
+
+        v2 = value;
+
+        return true;
+    }
+
+    inline void flush( QPolygonF &points ) const
+    {
+        double min = vMin;
+        double max = vMax;
+
+        points += QPointF( p0, v1 );
+
+        if ( v2 > v1 )
+            qSwap( min, max );
+
+        if ( max != v1 )
+            points += QPointF( p0, max );
+
+        if ( min != max )
+            points += QPointF( p0, min );
+
+        if ( v2 != min )
+            points += QPointF( p0, v2 );
+    }
+
+private:
+    double p0, v1, vMin, vMax, v2;
+};
+
+static QPolygonF qwtReducedTube(
+    const QwtSeriesData<QwtIntervalSample> *series, Qt::Orientation orientation,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    int from, int to, int &numLower )
+{
+    const QwtScaleMap &posMap = ( orientation == Qt::Vertical ) ? xMap : yMap;
+    const QwtScaleMap &valueMap = ( orientation == Qt::Vertical ) ? yMap : xMap;
+
+    // points are collected as ( position, value )
+    QPolygonF lowerPoints, upperPoints;
+
+    QwtIntervalQuadrupel lower, upper;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtIntervalSample s = series->sample( i );
+
+        const double pos = qRound( posMap.transform( s.value ) );
+        const double v1 = qRound( valueMap.transform( s.interval.minValue() ) );
+        const double v2 = qRound( valueMap.transform( s.interval.maxValue() ) );
+
+        if ( i == from )
+        {
+            lower.start( pos, v1 );
+            upper.start( pos, v2 );
+            continue;
+        }
+
+        if ( !lower.append( pos, v1 ) )
+        {
+            lower.flush( lowerPoints );
+            lower.start( pos, v1 );
+        }
+
+        if ( !upper.append( pos, v2 ) )
+        {
+            upper.flush( upperPoints );
+            upper.start( pos, v2 );
+        }
+    }
+
+    lower.flush( lowerPoints );
+    upper.flush( upperPoints );
+
+    numLower = lowerPoints.size();
+
+    // the upper bound is appended in reverse order
+
+    QPolygonF polygon( lowerPoints.size() + upperPoints.size() );
+    QPointF *points = polygon.data();
+
+    for ( int i = 0; i < lowerPoints.size(); i++ )
+        *points++ = lowerPoints[i];
+
+    for ( int i = upperPoints.size() - 1; i >= 0; i-- )
+        *points++ = upperPoints[i];
+
+    if ( orientation == Qt::Horizontal )
+    {
+        for ( int i = 0; i < polygon.size(); i++ )
+        {
+            QPointF &point = polygon[i];
+            point = QPointF( point.y(), point.x() );
+        }
+    }
+
+    return polygon;
+}
+
+static inline void qwtDrawIntervalSymbol( QPainter *painter,
+    const QwtIntervalSymbol &symbol, Qt::Orientation orientation,
+    double pos, double v1, double v2 )
+{
+    if ( orientation == Qt::Vertical )
+        symbol.draw( painter, orientation, QPointF( pos, v1 ), QPointF( pos, v2 ) );
+    else
+        symbol.draw( painter, orientation, QPointF( v1, pos ), QPointF( v2, pos ) );
+}
+
 class QwtPlotIntervalCurve::PrivateData
 {
 public:
@@ -102,6 +230,7 @@ void QwtPlotIntervalCurve::init()
 {
     setItemAttribute( QwtPlotItem::Legend, true );
     setItemAttribute( QwtPlotItem::AutoScale, true );
+    setConcurrentRenderingType( typeid( QwtPlotIntervalCurve ) );
 
     d_data = new PrivateData;
     setData( new QwtIntervalSeriesData() );
@@ -374,52 +503,74 @@ void QwtPlotIntervalCurve::drawTube( QPainter *painter,
 
     painter->save();
 
-    const size_t size = to - from + 1;
-    QPolygonF polygon( 2 * size );
-    QPointF *points = polygon.data();
+    QPolygonF polygon;
+
+    // number of points of the lower bound, followed
+    // by the points of the upper bound in reverse order
+    int numLower = 0;
 
-    for ( uint i = 0; i < size; i++ )
+    if ( doAlign && ( d_data->paintAttributes & FilterPointsAggressive ) )
+    {
+        polygon = qwtReducedTube( data(), orientation(),
+            xMap, yMap, from, to, numLower );
+    }
+    else
     {
-        QPointF &minValue = points[i];
-        QPointF &maxValue = points[2 * size - 1 - i];
+        const size_t size = to - from + 1;
+        polygon.resize( 2 * size );
 
-        const QwtIntervalSample intervalSample = sample( from + i );
-        if ( orientation() == Qt::Vertical )
+        QPointF *points = polygon.data();
+
+        for ( uint i = 0; i < size; i++ )
         {
-            double x = xMap.transform( intervalSample.value );
-            double y1 = yMap.transform( intervalSample.interval.minValue() );
-            double y2 = yMap.transform( intervalSample.interval.maxValue() );
-            if ( doAlign )
+            QPointF &minValue = points[i];
+            QPointF &maxValue = points[2 * size - 1 - i];
+
+            const QwtIntervalSample intervalSample = sample( from + i );
+            if ( orientation() == Qt::Vertical )
             {
-                x = qRound( x );
-                y1 = qRound( y1 );
-                y2 = qRound( y2 );
+                double x = xMap.transform( intervalSample.value );
+                double y1 = yMap.transform( intervalSample.interval.minValue() );
+                double y2 = yMap.transform( intervalSample.interval.maxValue() );
+                if ( doAlign )
+                {
+                    x = qRound( x );
+                    y1 = qRound( y1 );
+                    y2 = qRound( y2 );
+                }
+
+                minValue.rx() = x;
+                minValue.ry() = y1;
+                maxValue.rx() = x;
+                maxValue.ry() = y2;
             }
-
-            minValue.rx() = x;
-            minValue.ry() = y1;
-            maxValue.rx() = x;
-            maxValue.ry() = y2;
-        }
-        else
-        {
-            double y = yMap.transform( intervalSample.value );
-            double x1 = xMap.transform( intervalSample.interval.minValue() );
-            double x2 = xMap.transform( intervalSample.interval.maxValue() );
-            if ( doAlign )
+            else
             {
-                y = qRound( y );
-                x1 = qRound( x1 );
-                x2 = qRound( x2 );
+                double y = yMap.transform( intervalSample.value );
+                double x1 = xMap.transform( intervalSample.interval.minValue() );
+                double x2 = xMap.transform( intervalSample.interval.maxValue() );
+                if ( doAlign )
+                {
+                    y = qRound( y );
+                    x1 = qRound( x1 );
+                    x2 = qRound( x2 );
+                }
+
+                minValue.rx() = x1;
+                minValue.ry() = y;
+                maxValue.rx() = x2;
+                maxValue.ry() = y;
             }
-
-            minValue.rx() = x1;
-            minValue.ry() = y;
-            maxValue.rx() = x2;
-            maxValue.ry() = y;
         }
+
+        numLower = size;
     }
 
+    const QPointF *points = polygon.constData();
+    const int numUpper = polygon.size() - numLower;
+
+    addPaintStatistics( to - from + 1, polygon.size() );
+
     if ( d_data->brush.style() != Qt::NoBrush )
     {
         painter->setPen( QPen( Qt::NoPen ) );
@@ -451,20 +602,20 @@ void QwtPlotIntervalCurve::drawTube( QPainter *painter,
 
             QPolygonF p;
 
-            p.resize( size );
-            ::memcpy( p.data(), points, size * sizeof( QPointF ) );
+            p.resize( numLower );
+            ::memcpy( p.data(), points, numLower * sizeof( QPointF ) );
             p = QwtClipper::clipPolygonF( clipRect, p );
             QwtPainter::drawPolyline( painter, p );
 
-            p.resize( size );
-            ::memcpy( p.data(), points + size, size * sizeof( QPointF ) );
+            p.resize( numUpper );
+            ::memcpy( p.data(), points + numLower, numUpper * sizeof( QPointF ) );
             p = QwtClipper::clipPolygonF( clipRect, p );
             QwtPainter::drawPolyline( painter, p );
         }
         else
         {
-            QwtPainter::drawPolyline( painter, points, size );
-            QwtPainter::drawPolyline( painter, points + size, size );
+            QwtPainter::drawPolyline( painter, points, numLower );
+            QwtPainter::drawPolyline( painter, points + numLower, numUpper );
         }
     }
 
@@ -506,6 +657,72 @@ void QwtPlotIntervalCurve::drawSymbols(
 
     const bool doClip = d_data->paintAttributes & ClipSymbol;
 
+    if ( ( d_data->paintAttributes & FilterPointsAggressive )
+        && QwtPainter::roundingAlignment( painter ) )
+    {
+        /*
+          Samples being mapped to the same position are merged
+          into one symbol covering all of their intervals
+         */
+
+        const bool isVertical = ( orientation() == Qt::Vertical );
+
+        const QwtScaleMap &posMap = isVertical ? xMap : yMap;
+        const QwtScaleMap &valueMap = isVertical ? yMap : xMap;
+
+        bool hasSymbol = false;
+        double pos0 = 0.0, vMin = 0.0, vMax = 0.0;
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtIntervalSample s = sample( i );
+
+            if ( doClip )
+            {
+                const bool isInside = isVertical
+                    ? qwtIsVSampleInside( s, xMin, xMax, yMin, yMax )
+                    : qwtIsHSampleInside( s, xMin, xMax, yMin, yMax );
+
+                if ( !isInside )
+                    continue;
+            }
+
+            const double pos = qRound( posMap.transform( s.value ) );
+
+            double v1 = valueMap.transform( s.interval.minValue() );
+            double v2 = valueMap.transform( s.interval.maxValue() );
+            if ( v1 > v2 )
+                qSwap( v1, v2 );
+
+            if ( hasSymbol && pos == pos0 )
+            {
+                vMin = qMin( vMin, v1 );
+                vMax = qMax( vMax, v2 );
+                continue;
+            }
+
+            if ( hasSymbol )
+            {
+                qwtDrawIntervalSymbol( painter, symbol,
+                    orientation(), pos0, vMin, vMax );
+            }
+
+            hasSymbol = true;
+            pos0 = pos;
+            vMin = v1;
+            vMax = v2;
+        }
+
+        if ( hasSymbol )
+        {
+            qwtDrawIntervalSymbol( painter, symbol,
+                orientation(), pos0, vMin, vMax );
+        }
+
+        painter->restore();
+        return;
+    }
+
     for ( int i = from; i <= to; i++ )
     {
         const QwtIntervalSample s = sample( i );
@@ -70,7 +70,23 @@ public:
         ClipPolygons = 0x01,
 
         //! Check if a symbol is on the plot canvas before painting it.
-        ClipSymbol   = 0x02
+        ClipSymbol   = 0x02,
+
+        /*!
+          Reduce the samples, that are mapped to the same position,
+          accepting minor visual differences.
+
+          Has only an effect, when drawing to a paint device in integer
+          coordinates ( f.e. all widgets on screen ). As it is done for
+          QwtPlotCurve::FilterPointsAggressive each bound of the tube
+          is reduced to 4 points ( first, min, max, last ) for each chunk
+          of samples with the same position. Symbols of these samples
+          are merged into one symbol covering all of their intervals.
+
+          The number of points of the tube is limited by 8 times
+          the width of the plot canvas then.
+         */
+        FilterPointsAggressive = 0x04
     };
 
     //! Paint attributes
@@ -14,6 +14,48 @@
 #include "qwt_scale_div.h"
 #include "qwt_graphic.h"
 #include <qpainter.h>
+#include <qcache.h>
+#include <qmutex.h>
+
+class QwtLegendIconCache
+{
+public:
+    static QwtLegendIconCache &instance();
+
+    bool find( const QByteArray &key, QwtGraphic &icon )
+    {
+        QMutexLocker locker( &d_mutex );
+
+        const QwtGraphic *cachedIcon = d_cache.object( key );
+        if ( cachedIcon == NULL )
+            return false;
+
+        icon = *cachedIcon;
+        return true;
+    }
+
+    void insert( const QByteArray &key, const QwtGraphic &icon )
+    {
+        QMutexLocker locker( &d_mutex );
+        d_cache.insert( key, new QwtGraphic( icon ) );
+    }
+
+private:
+    QwtLegendIconCache():
+        d_cache( 100 )
+    {
+    }
+
+    QMutex d_mutex;
+    QCache<QByteArray, QwtGraphic> d_cache;
+};
+
+QwtLegendIconCache &QwtLegendIconCache::instance()
+{
+    // shared between all plot items
+    static QwtLegendIconCache cache;
+    return cache;
+}
 
 class QwtPlotItem::PrivateData
 {
@@ -25,10 +67,13 @@ public:
         interests( 0 ),
         renderHints( 0 ),
         renderThreadCount( 1 ),
+        concurrentType( NULL ),
         z( 0.0 ),
         xAxis( QwtPlot::xBottom ),
         yAxis( QwtPlot::yLeft ),
-        legendIconSize( 8, 8 )
+        legendIconSize( 8, 8 ),
+        numPaintedSamples( 0 ),
+        numPaintedPoints( 0 )
     {
     }
 
@@ -42,6 +87,9 @@ public:
     QwtPlotItem::RenderHints renderHints;
     uint renderThreadCount;
 
+    // ConcurrentRendering is enabled for objects of this type only
+    const std::type_info *concurrentType;
+
     double z;
 
     int xAxis;
@@ -49,6 +97,9 @@ public:
 
     QwtText title;
     QSize legendIconSize;
+
+    size_t numPaintedSamples;
+    size_t numPaintedPoints;
 };
 
 /*!
@@ -211,6 +262,9 @@ const QwtText &QwtPlotItem::title() const
 */
 void QwtPlotItem::setItemAttribute( ItemAttribute attribute, bool on )
 {
+    if ( attribute == QwtPlotItem::ConcurrentRendering )
+        d_data->concurrentType = NULL;
+
     if ( d_data->attributes.testFlag( attribute ) != on )
     {
         if ( on )
@@ -234,9 +288,56 @@ void QwtPlotItem::setItemAttribute( ItemAttribute attribute, bool on )
 */
 bool QwtPlotItem::testItemAttribute( ItemAttribute attribute ) const
 {
+    if ( attribute == QwtPlotItem::ConcurrentRendering
+        && d_data->concurrentType != NULL )
+    {
+        if ( typeid( *this ) != *d_data->concurrentType )
+            return false;
+    }
+
     return d_data->attributes.testFlag( attribute );
 }
 
+/*!
+   \brief Size of a text, when being painted on the canvas
+
+   As the font of the text might not be set explicitly, the maximum
+   of the sizes for the font of the canvas and the default font is
+   returned.
+
+   \param text Text
+   \return Size of the text
+*/
+QSizeF QwtPlotItem::canvasTextSize( const QwtText &text ) const
+{
+    // The painter of the canvas is initialized with the font of
+    // the canvas or with the default font, when painting to a backing store
+
+    QSizeF size = text.textSize( QFont() );
+
+    if ( d_data->plot && d_data->plot->canvas() )
+        size = size.expandedTo( text.textSize( d_data->plot->canvas()->font() ) );
+
+    return size;
+}
+
+/*!
+   \brief Enable ConcurrentRendering for objects of a specific type
+
+   Derived classes of an item, that can be rendered concurrently,
+   might access shared state in their reimplementations of draw().
+   So the attribute is enabled for objects of this type only,
+   unless it is set explicitly by setItemAttribute().
+
+   \param type Type of the class, that calls it in its constructor
+   \sa ItemAttribute, testItemAttribute()
+*/
+void QwtPlotItem::setConcurrentRenderingType( const std::type_info &type )
+{
+    d_data->attributes |= QwtPlotItem::ConcurrentRendering;
+    d_data->concurrentType = &type;
+}
+
 /*!
    Toggle an item interest
 
@@ -377,6 +478,65 @@ QwtGraphic QwtPlotItem::legendIcon(
     return QwtGraphic();
 }
 
+/*!
+   \brief Return a key identifying the legend icon
+
+   Plot items with the same key share their legend icons, that
+   are recorded once and cached afterwards. Changing the data
+   of an item doesn't regenerate the icon - as long as its key
+   doesn't change.
+
+   A key has to include all attributes of the item, that have an
+   effect on legendIcon(). The default implementation returns an
+   empty key, indicating that the icon must not be cached.
+
+   \param index Index of the legend entry
+                ( usually there is only one )
+   \param size Icon size
+
+   \return Key of the icon
+   \sa legendIcon(), cachedLegendIcon(), legendData()
+ */
+QByteArray QwtPlotItem::legendIconKey(
+    int index, const QSizeF &size ) const
+{
+    Q_UNUSED( index )
+    Q_UNUSED( size )
+
+    return QByteArray();
+}
+
+/*!
+   \brief Return a legend icon from the cache of legend icons
+
+   When there is no icon for the key in the cache, legendIcon() is
+   called and its result is inserted into the cache.
+
+   \param key Key of the icon, see legendIconKey()
+   \param index Index of the legend entry
+   \param size Icon size
+
+   \return Icon representing the item on the legend
+   \note An empty key bypasses the cache
+ */
+QwtGraphic QwtPlotItem::cachedLegendIcon( const QByteArray &key,
+    int index, const QSizeF &size ) const
+{
+    if ( key.isEmpty() )
+        return legendIcon( index, size );
+
+    QwtGraphic icon;
+    if ( !QwtLegendIconCache::instance().find( key, icon ) )
+    {
+        icon = legendIcon( index, size );
+        icon.optimize();
+
+        QwtLegendIconCache::instance().insert( key, icon );
+    }
+
+    return icon;
+}
+
 /*!
    \brief Return a default icon from a brush
 
@@ -405,6 +565,59 @@ QwtGraphic QwtPlotItem::defaultIcon(
     return icon;
 }   
 
+/*!
+   Reset the paint statistics
+
+   QwtPlot resets the statistics before drawing the item, when
+   the QwtPlot::RecordFrames attribute is enabled.
+
+   \sa getPaintStatistics(), addPaintStatistics()
+ */
+void QwtPlotItem::resetPaintStatistics()
+{
+    d_data->numPaintedSamples = 0;
+    d_data->numPaintedPoints = 0;
+}
+
+/*!
+   \brief Number of samples and points, that have been painted
+          since the last resetPaintStatistics()
+
+   \param numSamples Number of samples, that have been passed to
+                     the paint routines of the item
+   \param numPoints Number of points, that have been passed to the 
+                    painter after filtering and clipping
+
+   \note Only items reporting their numbers with addPaintStatistics()
+         return values > 0
+   \sa resetPaintStatistics(), QwtPlotFrameRecord
+ */
+void QwtPlotItem::getPaintStatistics( 
+    size_t &numSamples, size_t &numPoints ) const
+{
+    numSamples = d_data->numPaintedSamples;
+    numPoints = d_data->numPaintedPoints;
+}
+
+/*!
+   Add numbers to the paint statistics
+
+   Derived classes might call addPaintStatistics() from their
+   draw() implementation, to indicate how many samples have been 
+   processed and how many points have been passed to the painter.
+
+   \param numSamples Number of processed samples
+   \param numPoints Number of painted points
+
+   \sa getPaintStatistics()
+ */
+void QwtPlotItem::addPaintStatistics( 
+    size_t numSamples, size_t numPoints ) const
+{
+    d_data->numPaintedSamples += numSamples;
+    d_data->numPaintedPoints += numPoints;
+}
+
 //! Show the item
 void QwtPlotItem::show()
 {
@@ -445,12 +658,16 @@ bool QwtPlotItem::isVisible() const
    Update the legend and call QwtPlot::autoRefresh() for the
    parent plot.
 
+   When the QwtPlot::PartialReplot attribute is enabled the plot
+   might repaint the area of the previous and the current 
+   paintBoundingRect() only.
+
    \sa QwtPlot::legendChanged(), QwtPlot::autoRefresh()
 */
 void QwtPlotItem::itemChanged()
 {
     if ( d_data->plot )
-        d_data->plot->autoRefresh();
+        d_data->plot->autoRefreshItem( this );
 }
 
 /*!
@@ -539,6 +756,37 @@ QRectF QwtPlotItem::boundingRect() const
     return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
 }
 
+/*!
+   \brief Calculate the area on the canvas, that is painted by the item
+
+   The paint bounding rectangle is used by QwtPlot in 
+   QwtPlot::PartialReplot mode to find out, which part of the canvas 
+   needs to be repainted, when the item has changed, and which items
+   need to be painted, when only a part of the canvas is updated.
+
+   The default implementation returns the complete canvasRect.
+   Derived classes should return a rectangle, that covers all pixels
+   that might be painted by draw(), including pen widths, symbols and
+   labels.
+
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+
+   \return Bounding rectangle of the painted area in painter coordinates.
+           An invalid rectangle indicates, that nothing is painted.
+
+   \sa draw(), QwtPlot::PartialReplot
+ */
+QRectF QwtPlotItem::paintBoundingRect( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QRectF &canvasRect ) const
+{
+    Q_UNUSED( xMap );
+    Q_UNUSED( yMap );
+
+    return canvasRect;
+}
+
 /*!
    \brief Calculate a hint for the canvas margin
 
@@ -587,7 +835,8 @@ void QwtPlotItem::getCanvasMarginHint( const QwtScaleMap &xMap,
    by the receiver that acts as the legend.
 
    The default implementation returns one entry with 
-   the title() of the item and the legendIcon().
+   the title() of the item and the legendIcon(), that is taken
+   from a cache, when the item returns a legendIconKey().
 
    \return Data, that is needed to represent the item on the legend
    \sa title(), legendIcon(), QwtLegend, QwtPlotLegendItem
@@ -603,12 +852,18 @@ QList<QwtLegendData> QwtPlotItem::legendData() const
     qVariantSetValue( titleValue, label );
     data.setValue( QwtLegendData::TitleRole, titleValue );
         
-    const QwtGraphic graphic = legendIcon( 0, legendIconSize() );
+    const QSizeF iconSize = legendIconSize();
+    const QByteArray iconKey = legendIconKey( 0, iconSize );
+
+    const QwtGraphic graphic = cachedLegendIcon( iconKey, 0, iconSize );
     if ( !graphic.isNull() )
     {   
         QVariant iconValue;
         qVariantSetValue( iconValue, graphic );
         data.setValue( QwtLegendData::IconRole, iconValue );
+
+        if ( !iconKey.isEmpty() )
+            data.setValue( QwtLegendData::IconKeyRole, iconKey );
     }   
         
     QList<QwtLegendData> list;
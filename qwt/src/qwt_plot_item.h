@@ -17,6 +17,7 @@
 #include <qrect.h>
 #include <qlist.h>
 #include <qmetatype.h>
+#include <typeinfo>
 
 class QPainter;
 class QwtScaleMap;
@@ -156,7 +157,41 @@ public:
            its bounding rectangle. 
            \sa getCanvasMarginHint()
          */
-        Margins = 0x04
+        Margins = 0x04,
+
+        /*!
+           The item can be rendered in a separate thread into a 
+           transparent image, that is composed with the images 
+           of the other items afterwards.
+
+           The item has to be painted in draw() without accessing
+           any state, that is shared with other items.
+
+           The attribute is enabled by default for the series items
+           and markers of Qwt. For classes derived from them it is
+           disabled, unless it has been enabled explicitly,
+           as a reimplementation of f.e. drawSeries() might
+           access widgets or other shared state.
+           
+           \sa QwtPlot::setRenderThreadCount()
+         */
+        ConcurrentRendering = 0x08,
+
+        /*!
+           The boundingRect() of the item can be calculated in a separate
+           thread, while the bounding rectangles of other items are
+           calculated in parallel.
+
+           Series items usually iterate over all samples of their
+           QwtSeriesData, so QwtSeriesData::boundingRect() has to be
+           thread-safe too - f.e. it must not access buffers, that
+           might be modified by the GUI thread.
+
+           The attribute is disabled by default.
+
+           \sa QwtPlot::updateAxes(), QwtPlot::setRenderThreadCount()
+         */
+        ConcurrentBoundingRect = 0x10
     };
 
     //! Plot Item Attributes
@@ -268,6 +303,10 @@ public:
 
     virtual QRectF boundingRect() const;
 
+    virtual QRectF paintBoundingRect(
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect ) const;
+
     virtual void getCanvasMarginHint( 
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasSize,
@@ -285,10 +324,23 @@ public:
     virtual QList<QwtLegendData> legendData() const;
 
     virtual QwtGraphic legendIcon( int index, const QSizeF  & ) const;
+    virtual QByteArray legendIconKey( int index, const QSizeF & ) const;
+
+    void resetPaintStatistics();
+    void getPaintStatistics( size_t &numSamples, size_t &numPoints ) const;
 
 protected:
     QwtGraphic defaultIcon( const QBrush &, const QSizeF & ) const;
 
+    QwtGraphic cachedLegendIcon( const QByteArray &key,
+        int index, const QSizeF & ) const;
+
+    void addPaintStatistics( size_t numSamples, size_t numPoints ) const;
+
+    QSizeF canvasTextSize( const QwtText & ) const;
+
+    void setConcurrentRenderingType( const std::type_info & );
+
 private:
     // Disabled copy constructor and operator=
     QwtPlotItem( const QwtPlotItem & );
@@ -14,11 +14,13 @@
 #include "qwt_abstract_legend.h"
 #include <qscrollbar.h>
 #include <qmath.h>
+#include <qmap.h>
 
 class QwtPlotLayout::LayoutData
 {
 public:
     void init( const QwtPlot *, const QRectF &rect );
+    bool operator==( const LayoutData & ) const;
 
     struct t_legendData
     {
@@ -50,6 +52,7 @@ public:
         int baseLineOffset;
         double tickOffset;
         int dimWithoutTitle;
+        QwtText title;
     } scale[QwtPlot::axisCnt];
 
     struct t_canvasData
@@ -86,6 +89,13 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
 
         legend.hint = QSize( w, h );
     }
+    else
+    {
+        legend.frameWidth = 0;
+        legend.hScrollExtent = 0;
+        legend.vScrollExtent = 0;
+        legend.hint = QSize();
+    }
 
     // title
 
@@ -146,7 +156,8 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
             scale[axis].dimWithoutTitle = scaleWidget->dimForLength(
                 QWIDGETSIZE_MAX, scale[axis].scaleFont );
 
-            if ( !scaleWidget->title().isEmpty() )
+            scale[axis].title = scaleWidget->title();
+            if ( !scale[axis].title.isEmpty() )
             {
                 scale[axis].dimWithoutTitle -=
                     scaleWidget->titleHeightForWidth( QWIDGETSIZE_MAX );
@@ -155,6 +166,8 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         else
         {
             scale[axis].isEnabled = false;
+            scale[axis].scaleWidget = NULL;
+            scale[axis].title = QwtText();
             scale[axis].start = 0;
             scale[axis].end = 0;
             scale[axis].baseLineOffset = 0;
@@ -172,11 +185,132 @@ void QwtPlotLayout::LayoutData::init( const QwtPlot *plot, const QRectF &rect )
         &canvas.contentsMargins[ QwtPlot::xBottom ] );
 }
 
+/*
+  Compare all layout relevant data
+*/
+bool QwtPlotLayout::LayoutData::operator==( const LayoutData &other ) const
+{
+    if ( legend.frameWidth != other.legend.frameWidth
+        || legend.hScrollExtent != other.legend.hScrollExtent
+        || legend.vScrollExtent != other.legend.vScrollExtent
+        || legend.hint != other.legend.hint )
+    {
+        return false;
+    }
+
+    if ( title.frameWidth != other.title.frameWidth
+        || title.text != other.title.text )
+    {
+        return false;
+    }
+
+    if ( footer.frameWidth != other.footer.frameWidth
+        || footer.text != other.footer.text )
+    {
+        return false;
+    }
+
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+    {
+        const t_scaleData &s1 = scale[axis];
+        const t_scaleData &s2 = other.scale[axis];
+
+        if ( s1.isEnabled != s2.isEnabled )
+            return false;
+
+        if ( s1.isEnabled )
+        {
+            if ( s1.scaleWidget != s2.scaleWidget
+                || s1.scaleFont != s2.scaleFont
+                || s1.start != s2.start || s1.end != s2.end
+                || s1.baseLineOffset != s2.baseLineOffset
+                || s1.tickOffset != s2.tickOffset
+                || s1.dimWithoutTitle != s2.dimWithoutTitle
+                || s1.title != s2.title )
+            {
+                return false;
+            }
+        }
+
+        if ( canvas.contentsMargins[axis] != other.canvas.contentsMargins[axis] )
+            return false;
+    }
+
+    return true;
+}
+
+/*
+  Memoized results of QwtText::heightForWidth() for a text
+ */
+class QwtTextHeightCache
+{
+public:
+    int heightForWidth( const QwtText &text,
+        double width, const QFont &font = QFont() )
+    {
+        if ( text != d_text || font != d_font )
+        {
+            d_text = text;
+            d_font = font;
+            d_heights.clear();
+        }
+
+        QMap<double, int>::const_iterator it = d_heights.constFind( width );
+        if ( it != d_heights.constEnd() )
+            return it.value();
+
+        if ( d_heights.size() >= 32 )
+        {
+            // usually we have a couple of widths only, but
+            // resizing a plot creates a new one for each size
+            d_heights.clear();
+        }
+
+        const int height = qCeil( text.heightForWidth( width, font ) );
+        d_heights.insert( width, height );
+
+        return height;
+    }
+
+private:
+    QwtText d_text;
+    QFont d_font;
+    QMap<double, int> d_heights;
+};
+
+/*
+  Geometries of the last activation and the input,
+  they have been calculated from
+ */
+class QwtPlotLayoutCache
+{
+public:
+    QwtPlotLayoutCache():
+        isValid( false ),
+        hasLegend( false )
+    {
+    }
+
+    bool isValid;
+
+    QRectF plotRect;
+    QwtPlotLayout::Options options;
+    bool hasLegend;
+    QwtPlotLayout::LayoutData layoutData;
+
+    QRectF titleRect;
+    QRectF footerRect;
+    QRectF legendRect;
+    QRectF scaleRect[QwtPlot::axisCnt];
+    QRectF canvasRect;
+};
+
 class QwtPlotLayout::PrivateData
 {
 public:
     PrivateData():
-        spacing( 5 )
+        spacing( 5 ),
+        isCached( false )
     {
     }
 
@@ -193,6 +327,13 @@ public:
     unsigned int spacing;
     unsigned int canvasMargin[QwtPlot::axisCnt];
     bool alignCanvasToScales[QwtPlot::axisCnt];
+
+    QwtPlotLayoutCache layoutCache;
+    bool isCached;
+
+    QwtTextHeightCache titleHeights;
+    QwtTextHeightCache footerHeights;
+    QwtTextHeightCache scaleTitleHeights[QwtPlot::axisCnt];
 };
 
 /*!
@@ -241,6 +382,8 @@ void QwtPlotLayout::setCanvasMargin( int margin, int axis )
     }
     else if ( axis >= 0 && axis < QwtPlot::axisCnt )
         d_data->canvasMargin[axis] = margin;
+
+    d_data->layoutCache.isValid = false;
 }
 
 /*!
@@ -266,6 +409,8 @@ void QwtPlotLayout::setAlignCanvasToScales( bool on )
 {
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->alignCanvasToScales[axis] = on;
+
+    d_data->layoutCache.isValid = false;
 }
 
 /*!
@@ -289,6 +434,8 @@ void QwtPlotLayout::setAlignCanvasToScale( int axisId, bool on )
 {
     if ( axisId >= 0 && axisId < QwtPlot::axisCnt )
         d_data->alignCanvasToScales[axisId] = on;
+
+    d_data->layoutCache.isValid = false;
 }
 
 /*!
@@ -318,6 +465,7 @@ bool QwtPlotLayout::alignCanvasToScale( int axisId ) const
 void QwtPlotLayout::setSpacing( int spacing )
 {
     d_data->spacing = qMax( 0, spacing );
+    d_data->layoutCache.isValid = false;
 }
 
 /*!
@@ -366,6 +514,8 @@ void QwtPlotLayout::setLegendPosition( QwtPlot::LegendPosition pos, double ratio
         default:
             break;
     }
+
+    d_data->layoutCache.isValid = false;
 }
 
 /*!
@@ -547,6 +697,28 @@ void QwtPlotLayout::invalidate()
 
     for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
         d_data->scaleRect[axis] = QRect();
+
+    d_data->layoutCache.isValid = false;
+    d_data->isCached = false;
+}
+
+/*!
+  \brief Check if the geometries of the last activate() have been
+         taken from the cache
+
+  activate() memoizes its result together with all layout
+  relevant parameters of the plot components: extents of
+  the tick labels, fonts, texts and sizes of title, footer and legend.
+  As long as none of them has changed - f.e when only the scale
+  values are shifted by panning - the geometries of the previous
+  calculation are reused.
+
+  \return True, when the geometries have been taken from the cache
+  \sa activate(), invalidate(), QwtPlotFrameRecord::numCachedLayouts
+*/
+bool QwtPlotLayout::isActivatedFromCache() const
+{
+    return d_data->isCached;
 }
 
 /*!
@@ -893,7 +1065,8 @@ void QwtPlotLayout::expandLineBreaks( Options options, const QRectF &rect,
                 w -= dimAxis[QwtPlot::yLeft] + dimAxis[QwtPlot::yRight];
             }
 
-            int d = qCeil( d_data->layoutData.title.text.heightForWidth( w ) );
+            int d = d_data->titleHeights.heightForWidth(
+                d_data->layoutData.title.text, w );
             if ( !( options & IgnoreFrames ) )
                 d += 2 * d_data->layoutData.title.frameWidth;
 
@@ -916,7 +1089,8 @@ void QwtPlotLayout::expandLineBreaks( Options options, const QRectF &rect,
                 w -= dimAxis[QwtPlot::yLeft] + dimAxis[QwtPlot::yRight];
             }
 
-            int d = qCeil( d_data->layoutData.footer.text.heightForWidth( w ) );
+            int d = d_data->footerHeights.heightForWidth(
+                d_data->layoutData.footer.text, w );
             if ( !( options & IgnoreFrames ) )
                 d += 2 * d_data->layoutData.footer.frameWidth;
 
@@ -979,9 +1153,11 @@ void QwtPlotLayout::expandLineBreaks( Options options, const QRectF &rect,
                 }
 
                 int d = scaleData.dimWithoutTitle;
-                if ( !scaleData.scaleWidget->title().isEmpty() )
+                if ( !scaleData.title.isEmpty() )
                 {
-                    d += scaleData.scaleWidget->titleHeightForWidth( qFloor( length ) );
+                    // = scaleData.scaleWidget->titleHeightForWidth()
+                    d += d_data->scaleTitleHeights[axis].heightForWidth(
+                        scaleData.title, qFloor( length ), scaleData.scaleFont );
                 }
 
 
@@ -1266,14 +1442,15 @@ void QwtPlotLayout::alignScales( Options options,
   \param plotRect Rectangle where to place the components
   \param options Layout options
 
+  \note When all layout relevant parameters are unchanged since
+        the previous call, the geometries are taken from a cache.
+
   \sa invalidate(), titleRect(), footerRect()
-      legendRect(), scaleRect(), canvasRect()
+      legendRect(), scaleRect(), canvasRect(), isActivatedFromCache()
 */
 void QwtPlotLayout::activate( const QwtPlot *plot,
     const QRectF &plotRect, Options options )
 {
-    invalidate();
-
     QRectF rect( plotRect );  // undistributed rest of the plot rect
 
     // We extract all layout relevant parameters from the widgets,
@@ -1281,8 +1458,30 @@ void QwtPlotLayout::activate( const QwtPlot *plot,
 
     d_data->layoutData.init( plot, rect );
 
-    if ( !( options & IgnoreLegend )
-        && plot->legend() && !plot->legend()->isEmpty() )
+    const bool hasLegend = !( options & IgnoreLegend )
+        && plot->legend() && !plot->legend()->isEmpty();
+
+    QwtPlotLayoutCache &cache = d_data->layoutCache;
+    if ( cache.isValid && cache.plotRect == plotRect
+        && cache.options == options && cache.hasLegend == hasLegend
+        && cache.layoutData == d_data->layoutData )
+    {
+        // nothing has changed, that has an effect on the geometries
+
+        d_data->titleRect = cache.titleRect;
+        d_data->footerRect = cache.footerRect;
+        d_data->legendRect = cache.legendRect;
+        for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+            d_data->scaleRect[axis] = cache.scaleRect[axis];
+        d_data->canvasRect = cache.canvasRect;
+
+        d_data->isCached = true;
+        return;
+    }
+
+    invalidate();
+
+    if ( hasLegend )
     {
         d_data->legendRect = layoutLegend( options, rect );
 
@@ -1441,4 +1640,18 @@ void QwtPlotLayout::activate( const QwtPlot *plot,
 
         d_data->legendRect = alignLegend( d_data->canvasRect, d_data->legendRect );
     }
+
+    cache.plotRect = plotRect;
+    cache.options = options;
+    cache.hasLegend = hasLegend;
+    cache.layoutData = d_data->layoutData;
+
+    cache.titleRect = d_data->titleRect;
+    cache.footerRect = d_data->footerRect;
+    cache.legendRect = d_data->legendRect;
+    for ( int axis = 0; axis < QwtPlot::axisCnt; axis++ )
+        cache.scaleRect[axis] = d_data->scaleRect[axis];
+    cache.canvasRect = d_data->canvasRect;
+
+    cache.isValid = true;
 }
@@ -85,6 +85,8 @@ public:
 
     virtual void invalidate();
 
+    bool isActivatedFromCache() const;
+
     QRectF titleRect() const;
     QRectF footerRect() const;
     QRectF legendRect() const;
@@ -14,6 +14,7 @@
 #include "qwt_text.h"
 #include "qwt_math.h"
 #include <qpainter.h>
+#include <typeinfo>
 
 class QwtPlotMarker::PrivateData
 {
@@ -52,6 +53,12 @@ QwtPlotMarker::QwtPlotMarker( const QString &title ):
     QwtPlotItem( QwtText( title ) )
 {
     d_data = new PrivateData;
+
+#if QT_VERSION >= 0x050000
+    // rendering text in other threads is not safe on all Qt4 platforms
+    setConcurrentRenderingType( typeid( QwtPlotMarker ) );
+#endif
+
     setZ( 30.0 );
 }
 
@@ -60,6 +67,12 @@ QwtPlotMarker::QwtPlotMarker( const QwtText &title ):
     QwtPlotItem( title )
 {
     d_data = new PrivateData;
+
+#if QT_VERSION >= 0x050000
+    // rendering text in other threads is not safe on all Qt4 platforms
+    setConcurrentRenderingType( typeid( QwtPlotMarker ) );
+#endif
+
     setZ( 30.0 );
 }
 
@@ -551,6 +564,87 @@ QRectF QwtPlotMarker::boundingRect() const
     return QRectF( d_data->xValue, d_data->yValue, 0.0, 0.0 );
 }
 
+/*!
+   \brief Calculate the area on the canvas, that is painted by the marker
+
+   The area includes the lines, the symbol and the label
+   of the marker.
+
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+
+   \return Bounding rectangle of the painted area
+   \sa QwtPlotItem::paintBoundingRect()
+ */
+QRectF QwtPlotMarker::paintBoundingRect( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QRectF &canvasRect ) const
+{
+    const QPointF pos( xMap.transform( d_data->xValue ), 
+        yMap.transform( d_data->yValue ) );
+
+    qreal pw2 = d_data->pen.widthF() / 2.0;
+    if ( pw2 < 0.5 )
+        pw2 = 0.5;
+
+    QRectF rect;
+
+    if ( d_data->style == QwtPlotMarker::HLine ||
+        d_data->style == QwtPlotMarker::Cross )
+    {
+        rect |= QRectF( canvasRect.left(), pos.y() - pw2,
+            canvasRect.width(), 2 * pw2 );
+    }
+
+    if ( d_data->style == QwtPlotMarker::VLine ||
+        d_data->style == QwtPlotMarker::Cross )
+    {
+        rect |= QRectF( pos.x() - pw2, canvasRect.top(),
+            2 * pw2, canvasRect.height() );
+    }
+
+    qreal symbolExtent = 0.0;
+    if ( d_data->symbol &&
+        ( d_data->symbol->style() != QwtSymbol::NoSymbol ) )
+    {
+        const QRectF symbolRect = 
+            QRectF( d_data->symbol->boundingRect() ).translated( pos );
+
+        rect |= symbolRect;
+
+        symbolExtent = 0.5 * qMax( symbolRect.width(), symbolRect.height() );
+    }
+
+    if ( !d_data->label.isEmpty() )
+    {
+        // As the alignment of the label is done in drawLabel(), that
+        // might be overloaded, we use a rectangle, that includes
+        // all possible alignments
+
+        const QSizeF textSize = canvasTextSize( d_data->label );
+
+        const qreal off = qMax( textSize.width(), textSize.height() )
+            + qMax( pw2, symbolExtent ) + d_data->spacing + 1.0;
+
+        QRectF labelRect( pos.x() - off, pos.y() - off, 2 * off, 2 * off );
+
+        if ( d_data->style == QwtPlotMarker::VLine )
+        {
+            labelRect.setTop( canvasRect.top() - off );
+            labelRect.setBottom( canvasRect.bottom() + off );
+        }
+        else if ( d_data->style == QwtPlotMarker::HLine )
+        {
+            labelRect.setLeft( canvasRect.left() - off );
+            labelRect.setRight( canvasRect.right() + off );
+        }
+
+        rect |= labelRect;
+    }
+
+    return rect;
+}
+
 /*!
    \return Icon representing the marker on the legend
 
@@ -112,6 +112,9 @@ public:
 
     virtual QRectF boundingRect() const;
 
+    virtual QRectF paintBoundingRect( const QwtScaleMap &,
+        const QwtScaleMap &, const QRectF &canvasRect ) const;
+
     virtual QwtGraphic legendIcon( int index, const QSizeF & ) const;
 
 protected:
@@ -14,6 +14,7 @@
 #include <qpainter.h>
 #include <qpalette.h>
 #include <qmap.h>
+#include <typeinfo>
 
 inline static bool qwtIsIncreasing(
     const QwtScaleMap &map, const QVector<double> &values )
@@ -74,6 +75,8 @@ void QwtPlotMultiBarChart::init()
 {
     d_data = new PrivateData;
     setData( new QwtSetSeriesData() );
+
+    setConcurrentRenderingType( typeid( QwtPlotMultiBarChart ) );
 }
 
 //! \return QwtPlotItem::Rtti_PlotBarChart
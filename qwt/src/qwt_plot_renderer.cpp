@@ -17,6 +17,7 @@
 #include "qwt_text.h"
 #include "qwt_text_label.h"
 #include "qwt_math.h"
+#include "qwt_null_paintdevice.h"
 #include <qpainter.h>
 #include <qpaintengine.h>
 #include <qtransform.h>
@@ -57,17 +58,862 @@ static QPainterPath qwtCanvasClip(
     return clipPath;
 }
 
+static inline bool qwtIsVectorDevice( const QPainter *painter )
+{
+    switch( painter->paintEngine()->type() )
+    {
+        case QPaintEngine::Pdf:
+        case QPaintEngine::SVG:
+        case QPaintEngine::PostScript:
+        case QPaintEngine::Picture:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/*
+  Reduces a chunk of consecutive points, that are in the same
+  column ( or row ) of the export resolution, to 4 points:
+
+  - first point
+  - point with the minimum coordinate
+  - point with the maximum coordinate
+  - last point
+
+  The points are not moved - only points, that are not visible
+  at the export resolution, are removed.
+ */
+class QwtPolylineReducer
+{
+public:
+    QwtPolylineReducer( const QTransform &transform,
+            double cellSize, Qt::Orientation orientation ):
+        d_transform( transform ),
+        d_cellSize( cellSize ),
+        d_orientation( orientation ),
+        d_count( 0 )
+    {
+    }
+
+    QPolygonF reduced( const QPointF *points, int numPoints )
+    {
+        d_polyline.clear();
+        d_count = 0;
+
+        for ( int i = 0; i < numPoints; i++ )
+            append( points[i] );
+
+        flush();
+
+        return d_polyline;
+    }
+
+private:
+    inline void append( const QPointF &point )
+    {
+        const QPointF pos = d_transform.map( point );
+
+        double cellPos, value;
+        if ( d_orientation == Qt::Horizontal )
+        {
+            cellPos = pos.x();
+            value = pos.y();
+        }
+        else
+        {
+            cellPos = pos.y();
+            value = pos.x();
+        }
+
+        const qint64 cell = qFloor( cellPos / d_cellSize );
+
+        if ( d_count > 0 && cell == d_cell )
+        {
+            if ( value < d_minValue )
+            {
+                d_minValue = value;
+                d_minIndex = d_count;
+                d_min = point;
+            }
+            else if ( value > d_maxValue )
+            {
+                d_maxValue = value;
+                d_maxIndex = d_count;
+                d_max = point;
+            }
+
+            d_last = point;
+            d_count++;
+
+            return;
+        }
+
+        flush();
+
+        d_cell = cell;
+        d_first = d_last = d_min = d_max = point;
+        d_minValue = d_maxValue = value;
+        d_minIndex = d_maxIndex = 0;
+        d_count = 1;
+    }
+
+    void flush()
+    {
+        if ( d_count <= 0 )
+            return;
+
+        d_polyline += d_first;
+
+        const int lastIndex = d_count - 1;
+
+        if ( d_minIndex < d_maxIndex )
+        {
+            if ( d_minIndex > 0 )
+                d_polyline += d_min;
+
+            if ( d_maxIndex < lastIndex )
+                d_polyline += d_max;
+        }
+        else if ( d_maxIndex < d_minIndex )
+        {
+            if ( d_maxIndex > 0 )
+                d_polyline += d_max;
+
+            if ( d_minIndex < lastIndex )
+                d_polyline += d_min;
+        }
+
+        if ( lastIndex > 0 )
+            d_polyline += d_last;
+
+        d_count = 0;
+    }
+
+    const QTransform d_transform;
+    const double d_cellSize;
+    const Qt::Orientation d_orientation;
+
+    QPolygonF d_polyline;
+
+    int d_count;
+    qint64 d_cell;
+
+    QPointF d_first, d_last, d_min, d_max;
+    double d_minValue, d_maxValue;
+    int d_minIndex, d_maxIndex;
+};
+
+/*
+  A small primitive, like a symbol of a scatter plot, that
+  might be rasterized together with its neighbours.
+ */
+class QwtExportPrimitive
+{
+public:
+    enum Type
+    {
+        Rect,
+        Ellipse,
+        Lines,
+        Polygon,
+        Path,
+        Pixmap
+    };
+
+    QwtExportPrimitive():
+        type( Path ),
+        mode( QPaintEngine::OddEvenMode )
+    {
+    }
+
+    Type type;
+
+    QRectF rect; // Rect, Ellipse, Pixmap
+    QPolygonF points; // Lines ( pairs of points ), Polygon
+    QPaintEngine::PolygonDrawMode mode;
+    QPainterPath path;
+
+    QPixmap pixmap;
+    QRectF subRect;
+};
+
+/*
+  A paint device, that passes all paint operations to a painter
+  of a vector device - beside of reducing them to what is visible
+  at the export resolution:
+
+  - polylines are reduced to the min/max points per column and row
+  - dense point clouds are rasterized to an image
+  - dense runs of small primitives ( f.e. symbols ) are rasterized
+    to an image
+  - images and pixmaps are downsampled
+
+  The operations are forwarded immediately - beside of a limited number
+  of small primitives, that are collected to decide about their density.
+  So no representation of the complete canvas is ever stored.
+ */
+class QwtPlotExportDevice: public QwtNullPaintDevice
+{
+public:
+    enum
+    {
+        // primitives being collected before deciding about their density
+        MaxPending = 1024,
+
+        // runs with less primitives are never rasterized
+        MinRasterized = 64,
+
+        // max. size of a small primitive in cells of the export resolution
+        MaxPrimitiveSize = 32
+    };
+
+    QwtPlotExportDevice( QPainter *painter, int resolution ):
+        d_painter( painter )
+    {
+        const QPaintDevice *device = painter->device();
+
+        d_cellSize = qMax(
+            double( device->logicalDpiX() ) / resolution, 1e-6 );
+
+        // the items align their coordinates like on the target device
+        setEngineType( painter->paintEngine()->type() );
+    }
+
+    virtual void drawRects( const QRect *rects, int count )
+    {
+        if ( count == 1 )
+        {
+            const QRectF rect( rects[0] );
+            drawRects( &rect, 1 );
+
+            return;
+        }
+
+        flush();
+        d_painter->drawRects( rects, count );
+    }
+
+    virtual void drawRects( const QRectF *rects, int count )
+    {
+        if ( count == 1 )
+        {
+            QwtExportPrimitive primitive;
+            primitive.type = QwtExportPrimitive::Rect;
+            primitive.rect = rects[0];
+
+            addPrimitive( primitive, rects[0] );
+            return;
+        }
+
+        flush();
+        d_painter->drawRects( rects, count );
+    }
+
+    virtual void drawLines( const QLine *lines, int count )
+    {
+        if ( count == 1 )
+        {
+            const QLineF line( lines[0] );
+            drawLines( &line, 1 );
+
+            return;
+        }
+
+        flush();
+        d_painter->drawLines( lines, count );
+    }
+
+    virtual void drawLines( const QLineF *lines, int count )
+    {
+        if ( count == 1 )
+        {
+            QwtExportPrimitive primitive;
+            primitive.type = QwtExportPrimitive::Lines;
+            primitive.points += lines[0].p1();
+            primitive.points += lines[0].p2();
+
+            addPrimitive( primitive, primitive.points.boundingRect() );
+            return;
+        }
+
+        flush();
+        d_painter->drawLines( lines, count );
+    }
+
+    virtual void drawEllipse( const QRectF &rect )
+    {
+        QwtExportPrimitive primitive;
+        primitive.type = QwtExportPrimitive::Ellipse;
+        primitive.rect = rect;
+
+        addPrimitive( primitive, rect );
+    }
+
+    virtual void drawEllipse( const QRect &rect )
+    {
+        drawEllipse( QRectF( rect ) );
+    }
+
+    virtual void drawPath( const QPainterPath &path )
+    {
+        QwtExportPrimitive primitive;
+        primitive.type = QwtExportPrimitive::Path;
+        primitive.path = path;
+
+        addPrimitive( primitive, path.controlPointRect() );
+    }
+
+    virtual void drawPoints( const QPoint *points, int count )
+    {
+        QPolygonF pointsF( count );
+        for ( int i = 0; i < count; i++ )
+            pointsF[i] = points[i];
+
+        drawPoints( pointsF.constData(), count );
+    }
+
+    virtual void drawPoints( const QPointF *points, int count )
+    {
+        flush();
+
+        if ( !drawPointsRaster( points, count ) )
+            d_painter->drawPoints( points, count );
+    }
+
+    virtual void drawPolygon( const QPoint *points, int count,
+        QPaintEngine::PolygonDrawMode mode )
+    {
+        QPolygonF pointsF( count );
+        for ( int i = 0; i < count; i++ )
+            pointsF[i] = points[i];
+
+        drawPolygon( pointsF.constData(), count, mode );
+    }
+
+    virtual void drawPolygon( const QPointF *points, int count,
+        QPaintEngine::PolygonDrawMode mode )
+    {
+        if ( mode != QPaintEngine::PolylineMode )
+        {
+            QwtExportPrimitive primitive;
+            primitive.type = QwtExportPrimitive::Polygon;
+            primitive.points = QPolygonF( count );
+            primitive.mode = mode;
+
+            for ( int i = 0; i < count; i++ )
+                primitive.points[i] = points[i];
+
+            addPrimitive( primitive, primitive.points.boundingRect() );
+            return;
+        }
+
+        flush();
+
+        if ( count > 2 )
+        {
+            const QTransform transform = d_painter->transform();
+
+            QwtPolylineReducer reducerX(
+                transform, d_cellSize, Qt::Horizontal );
+            const QPolygonF polylineX = reducerX.reduced( points, count );
+
+            QwtPolylineReducer reducerY(
+                transform, d_cellSize, Qt::Vertical );
+            const QPolygonF polyline =
+                reducerY.reduced( polylineX.constData(), polylineX.size() );
+
+            d_painter->drawPolyline( polyline );
+            return;
+        }
+
+        d_painter->drawPolyline( points, count );
+    }
+
+    virtual void drawPixmap( const QRectF &rect,
+        const QPixmap &pixmap, const QRectF &subRect )
+    {
+        QwtExportPrimitive primitive;
+        primitive.type = QwtExportPrimitive::Pixmap;
+        primitive.rect = rect;
+        primitive.pixmap = pixmap;
+        primitive.subRect = subRect;
+
+        addPrimitive( primitive, rect );
+    }
+
+    virtual void drawImage( const QRectF &rect, const QImage &image,
+        const QRectF &subRect, Qt::ImageConversionFlags flags )
+    {
+        flush();
+
+        const QSize size = reducedSize( rect, subRect.size() );
+        if ( size.isValid() )
+        {
+            const QImage img = image.copy( subRect.toAlignedRect() ).scaled(
+                size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+
+            d_painter->drawImage( rect, img, img.rect(), flags );
+        }
+        else
+        {
+            d_painter->drawImage( rect, image, subRect, flags );
+        }
+    }
+
+    virtual void drawTiledPixmap( const QRectF &rect,
+        const QPixmap &pixmap, const QPointF &subRect )
+    {
+        flush();
+        d_painter->drawTiledPixmap( rect, pixmap, subRect );
+    }
+
+    virtual void drawTextItem( const QPointF &pos, const QTextItem &textItem )
+    {
+        flush();
+        d_painter->drawTextItem( pos, textItem );
+    }
+
+    virtual void updateState( const QPaintEngineState &state )
+    {
+        // the collected primitives are painted with the previous state
+        flush();
+
+        QPainter *painter = d_painter;
+
+        const QPaintEngine::DirtyFlags flags = state.state();
+
+        if ( flags & QPaintEngine::DirtyPen )
+            painter->setPen( state.pen() );
+
+        if ( flags & QPaintEngine::DirtyBrush )
+            painter->setBrush( state.brush() );
+
+        if ( flags & QPaintEngine::DirtyBrushOrigin )
+            painter->setBrushOrigin( state.brushOrigin() );
+
+        if ( flags & QPaintEngine::DirtyFont )
+            painter->setFont( state.font() );
+
+        if ( flags & QPaintEngine::DirtyBackground )
+        {
+            painter->setBackgroundMode( state.backgroundMode() );
+            painter->setBackground( state.backgroundBrush() );
+        }
+
+        if ( flags & QPaintEngine::DirtyTransform )
+            painter->setTransform( state.transform() );
+
+        if ( flags & QPaintEngine::DirtyClipEnabled )
+            painter->setClipping( state.isClipEnabled() );
+
+        if ( flags & QPaintEngine::DirtyClipRegion)
+            painter->setClipRegion( state.clipRegion(), state.clipOperation() );
+
+        if ( flags & QPaintEngine::DirtyClipPath )
+            painter->setClipPath( state.clipPath(), state.clipOperation() );
+
+        if ( flags & QPaintEngine::DirtyHints)
+        {
+            const QPainter::RenderHints hints = state.renderHints();
+
+            painter->setRenderHints( painter->renderHints() & ~hints, false );
+            painter->setRenderHints( hints, true );
+        }
+
+        if ( flags & QPaintEngine::DirtyCompositionMode)
+            painter->setCompositionMode( state.compositionMode() );
+
+        if ( flags & QPaintEngine::DirtyOpacity)
+            painter->setOpacity( state.opacity() );
+    }
+
+    /*
+      Paint the primitives, that have been collected, to the target.
+      Needs to be called, when painting to the device has been finished.
+     */
+    void flush()
+    {
+        processPending();
+
+        if ( !d_layer.isNull() )
+        {
+            if ( !d_layerDirtyRect.isEmpty() )
+            {
+                const QRect r = d_layerDirtyRect & d_layer.rect();
+
+                const QRectF targetRect(
+                    d_layerRect.left() + r.x() * d_cellSize,
+                    d_layerRect.top() + r.y() * d_cellSize,
+                    r.width() * d_cellSize, r.height() * d_cellSize );
+
+                d_painter->save();
+                d_painter->resetTransform();
+                d_painter->drawImage( targetRect, d_layer.copy( r ) );
+                d_painter->restore();
+            }
+
+            d_layer = QImage();
+            d_layerRect = QRectF();
+            d_layerDirtyRect = QRect();
+        }
+    }
+
+protected:
+    virtual int metric( PaintDeviceMetric deviceMetric ) const
+    {
+        // font metrics and resolutions of the target device
+
+        const QPaintDevice *device = d_painter->device();
+
+        switch ( deviceMetric )
+        {
+            case PdmDpiX:
+                return device->logicalDpiX();
+            case PdmDpiY:
+                return device->logicalDpiY();
+            case PdmPhysicalDpiX:
+                return device->physicalDpiX();
+            case PdmPhysicalDpiY:
+                return device->physicalDpiY();
+            default:
+                return QwtNullPaintDevice::metric( deviceMetric );
+        }
+    }
+
+    virtual QSize sizeMetrics() const
+    {
+        const QPaintDevice *device = d_painter->device();
+        return QSize( device->width(), device->height() );
+    }
+
+private:
+    template <class Point>
+    static inline void drawPolygon( QPainter *painter, const Point *points,
+        int count, QPaintEngine::PolygonDrawMode mode )
+    {
+        switch( mode )
+        {
+            case QPaintEngine::PolylineMode:
+                painter->drawPolyline( points, count );
+                break;
+            case QPaintEngine::ConvexMode:
+                painter->drawConvexPolygon( points, count );
+                break;
+            case QPaintEngine::WindingMode:
+                painter->drawPolygon( points, count, Qt::WindingFill );
+                break;
+            default:
+                painter->drawPolygon( points, count, Qt::OddEvenFill );
+        }
+    }
+
+    void drawPrimitive( QPainter *painter,
+        const QwtExportPrimitive &primitive, bool reduce ) const
+    {
+        switch( primitive.type )
+        {
+            case QwtExportPrimitive::Rect:
+            {
+                painter->drawRects( &primitive.rect, 1 );
+                break;
+            }
+            case QwtExportPrimitive::Ellipse:
+            {
+                painter->drawEllipse( primitive.rect );
+                break;
+            }
+            case QwtExportPrimitive::Lines:
+            {
+                painter->drawLine( primitive.points[0], primitive.points[1] );
+                break;
+            }
+            case QwtExportPrimitive::Polygon:
+            {
+                drawPolygon( painter, primitive.points.constData(),
+                    primitive.points.size(), primitive.mode );
+                break;
+            }
+            case QwtExportPrimitive::Path:
+            {
+                painter->drawPath( primitive.path );
+                break;
+            }
+            case QwtExportPrimitive::Pixmap:
+            {
+                const QSize size = reduce ? reducedSize(
+                    primitive.rect, primitive.subRect.size() ) : QSize();
+
+                if ( size.isValid() )
+                {
+                    const QPixmap pm = primitive.pixmap.copy(
+                        primitive.subRect.toAlignedRect() ).scaled( size,
+                        Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+
+                    painter->drawPixmap( primitive.rect, pm, pm.rect() );
+                }
+                else
+                {
+                    painter->drawPixmap( primitive.rect,
+                        primitive.pixmap, primitive.subRect );
+                }
+                break;
+            }
+        }
+    }
+
+    double penWidth( const QTransform &transform ) const
+    {
+        // the pen width in device coordinates
+
+        const QPen pen = d_painter->pen();
+        if ( pen.style() == Qt::NoPen )
+            return 0.0;
+
+        double width = qMax( pen.widthF(), qreal( 1.0 ) );
+        if ( !pen.isCosmetic() )
+            width *= qMax( qAbs( transform.m11() ), qAbs( transform.m22() ) );
+
+        return width;
+    }
+
+    void addPrimitive( const QwtExportPrimitive &primitive, const QRectF &rect )
+    {
+        /*
+          Blending the primitives one by one gives a different
+          result for overlapping primitives, when using a
+          composition mode or opacity.
+         */
+
+        bool doCollect = ( d_painter->compositionMode()
+            == QPainter::CompositionMode_SourceOver )
+            && ( d_painter->opacity() >= 1.0 );
+
+        QRectF deviceRect;
+        if ( doCollect )
+        {
+            const QTransform transform = d_painter->transform();
+
+            const double pw = penWidth( transform );
+
+            deviceRect = transform.mapRect( rect );
+            deviceRect.adjust( -pw, -pw, pw, pw );
+
+            const double maxSize = MaxPrimitiveSize * d_cellSize;
+
+            doCollect = deviceRect.width() <= maxSize
+                && deviceRect.height() <= maxSize;
+        }
+
+        if ( !doCollect )
+        {
+            flush();
+            drawPrimitive( d_painter, primitive, true );
+
+            return;
+        }
+
+        d_pending += primitive;
+        d_pendingRect |= deviceRect;
+
+        if ( d_pending.size() >= MaxPending )
+            processPending();
+    }
+
+    void processPending()
+    {
+        if ( d_pending.isEmpty() )
+            return;
+
+        bool doRaster = !d_layer.isNull();
+        if ( !doRaster && d_pending.size() >= MinRasterized )
+        {
+            // primitives being denser than one for 4x4 pixels are rasterized
+
+            const double numCells = ( d_pendingRect.width() / d_cellSize )
+                * ( d_pendingRect.height() / d_cellSize );
+
+            doRaster = d_pending.size() >= numCells / 16;
+        }
+
+        if ( doRaster && d_layer.isNull() )
+            initLayer();
+
+        if ( doRaster && !d_layer.isNull() )
+        {
+            const QTransform transform = d_painter->transform();
+
+            QTransform imageTransform = transform;
+            imageTransform *= QTransform::fromTranslate(
+                -d_layerRect.left(), -d_layerRect.top() );
+            imageTransform *= QTransform::fromScale(
+                1.0 / d_cellSize, 1.0 / d_cellSize );
+
+            QPainter painter( &d_layer );
+            painter.setRenderHints( d_painter->renderHints() );
+            painter.setPen( d_painter->pen() );
+            painter.setBrush( d_painter->brush() );
+            painter.setBrushOrigin( d_painter->brushOrigin() );
+            painter.setTransform( imageTransform );
+
+            for ( int i = 0; i < d_pending.size(); i++ )
+                drawPrimitive( &painter, d_pending[i], false );
+
+            painter.end();
+
+            QRectF dirtyRect = d_pendingRect.translated( -d_layerRect.topLeft() );
+            dirtyRect = QRectF( dirtyRect.topLeft() / d_cellSize,
+                dirtyRect.size() / d_cellSize );
+
+            d_layerDirtyRect |= dirtyRect.toAlignedRect();
+        }
+        else if ( !doRaster )
+        {
+            for ( int i = 0; i < d_pending.size(); i++ )
+                drawPrimitive( d_painter, d_pending[i], true );
+        }
+
+        // without a layer the visible area is empty and
+        // the primitives can be discarded
+
+        d_pending.clear();
+        d_pendingRect = QRectF();
+    }
+
+    void initLayer()
+    {
+        // the layer covers the visible area of the target device
+
+        QRectF rect( QPointF( 0.0, 0.0 ), QSizeF( sizeMetrics() ) );
+        if ( d_painter->hasClipping() )
+        {
+            rect &= d_painter->transform().mapRect(
+                d_painter->clipRegion().boundingRect() );
+        }
+
+        const QSize imageSize( qCeil( rect.width() / d_cellSize ),
+            qCeil( rect.height() / d_cellSize ) );
+
+        if ( imageSize.isEmpty() )
+            return;
+
+        d_layer = QImage( imageSize, QImage::Format_ARGB32_Premultiplied );
+        d_layer.fill( 0u );
+
+        d_layerRect = rect;
+        d_layerDirtyRect = QRect();
+    }
+
+    QSize reducedSize( const QRectF &rect, const QSizeF &size ) const
+    {
+        // the size of the target rectangle at the export resolution
+
+        const QRectF r = d_painter->transform().mapRect( rect );
+
+        const int w = qCeil( r.width() / d_cellSize );
+        const int h = qCeil( r.height() / d_cellSize );
+
+        if ( w > 0 && h > 0 && ( w < size.width() || h < size.height() ) )
+            return QSize( qMin( w, qCeil( size.width() ) ),
+                qMin( h, qCeil( size.height() ) ) );
+
+        return QSize();
+    }
+
+    bool drawPointsRaster( const QPointF *points, int count ) const
+    {
+        if ( count < MinRasterized )
+            return false;
+
+        const QTransform transform = d_painter->transform();
+
+        QRectF boundingRect( transform.map( points[0] ), QSizeF() );
+        for ( int i = 1; i < count; i++ )
+        {
+            const QPointF pos = transform.map( points[i] );
+
+            boundingRect.setLeft( qMin( boundingRect.left(), pos.x() ) );
+            boundingRect.setRight( qMax( boundingRect.right(), pos.x() ) );
+            boundingRect.setTop( qMin( boundingRect.top(), pos.y() ) );
+            boundingRect.setBottom( qMax( boundingRect.bottom(), pos.y() ) );
+        }
+
+        const QPen pen = d_painter->pen();
+
+        double penWidth = qMax( pen.widthF(), qreal( 1.0 ) );
+        if ( !pen.isCosmetic() )
+            penWidth *= qMax( qAbs( transform.m11() ), qAbs( transform.m22() ) );
+
+        boundingRect.adjust( -penWidth, -penWidth, penWidth, penWidth );
+
+        if ( d_painter->hasClipping() )
+        {
+            boundingRect &= transform.mapRect(
+                d_painter->clipRegion().boundingRect() );
+        }
+
+        const QSize imageSize( qCeil( boundingRect.width() / d_cellSize ),
+            qCeil( boundingRect.height() / d_cellSize ) );
+
+        if ( imageSize.isEmpty() )
+            return true;
+
+        // points being denser than one for 4x4 pixels are rasterized
+
+        if ( count < ( double( imageSize.width() ) * imageSize.height() ) / 16 )
+            return false;
+
+        QImage image( imageSize, QImage::Format_ARGB32_Premultiplied );
+        image.fill( 0u );
+
+        QTransform imageTransform = transform;
+        imageTransform *= QTransform::fromTranslate(
+            -boundingRect.left(), -boundingRect.top() );
+        imageTransform *= QTransform::fromScale(
+            1.0 / d_cellSize, 1.0 / d_cellSize );
+
+        QPainter painter( &image );
+        painter.setRenderHints( d_painter->renderHints() );
+        painter.setPen( pen );
+        painter.setTransform( imageTransform );
+        painter.drawPoints( points, count );
+        painter.end();
+
+        d_painter->save();
+        d_painter->resetTransform();
+        d_painter->drawImage( boundingRect, image );
+        d_painter->restore();
+
+        return true;
+    }
+
+    QPainter *d_painter;
+    double d_cellSize;
+
+    // small primitives, that have not been painted yet
+    QVector<QwtExportPrimitive> d_pending;
+    QRectF d_pendingRect;
+
+    // image for rasterizing a dense run of small primitives
+    QImage d_layer;
+    QRectF d_layerRect;
+    QRect d_layerDirtyRect;
+};
+
 class QwtPlotRenderer::PrivateData
 {
 public:
     PrivateData():
         discardFlags( QwtPlotRenderer::DiscardNone ),
-        layoutFlags( QwtPlotRenderer::DefaultLayout )
+        layoutFlags( QwtPlotRenderer::DefaultLayout ),
+        vectorResolution( 0 )
     {
     }
 
     QwtPlotRenderer::DiscardFlags discardFlags;
     QwtPlotRenderer::LayoutFlags layoutFlags;
+    int vectorResolution;
 };
 
 /*! 
@@ -178,6 +1024,44 @@ QwtPlotRenderer::LayoutFlags QwtPlotRenderer::layoutFlags() const
     return d_data->layoutFlags;
 }
 
+/*!
+  \brief Set the resolution for simplifying the canvas items on vector devices
+
+  Rendering huge data sets to a vector graphics format ( PDF, SVG,
+  PostScript, QPicture ) results in documents, where most of the
+  primitives are not visible, when being displayed with the resolution
+  of a screen or printer.
+
+  When a resolution > 0 is set, the paint operations of the canvas items
+  are reduced to what is visible at this resolution, before they are
+  passed to the vector device:
+
+  - polylines are reduced to the points with the minimum and maximum
+    coordinate of each pixel column and row
+  - dense point clouds and dense runs of small primitives
+    ( f.e. the symbols of a scatter plot ) are embedded as image
+  - images and pixmaps are downsampled to the resolution
+
+  All other parts of the plot ( scales, titles, legend ) are not affected.
+  The default setting is 0, what disables the simplification.
+
+  \param dpi Resolution in dots per inch
+  \sa vectorResolution()
+ */
+void QwtPlotRenderer::setVectorResolution( int dpi )
+{
+    d_data->vectorResolution = qMax( dpi, 0 );
+}
+
+/*!
+  \return Resolution for simplifying the canvas items on vector devices
+  \sa setVectorResolution()
+ */
+int QwtPlotRenderer::vectorResolution() const
+{
+    return d_data->vectorResolution;
+}
+
 /*!
   Render a plot to a file
 
@@ -770,7 +1654,7 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
         painter->save();
 
         painter->setClipRect( canvasRect );
-        plot->drawItems( painter, canvasRect, map );
+        renderCanvasItems( plot, painter, canvasRect, map );
 
         painter->restore();
     }
@@ -794,7 +1678,7 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
         else
             painter->setClipPath( clipPath );
 
-        plot->drawItems( painter, canvasRect, map );
+        renderCanvasItems( plot, painter, canvasRect, map );
 
         painter->restore();
     }
@@ -832,7 +1716,7 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
             QwtPainter::drawBackgound( painter, innerRect, canvas );
         }
 
-        plot->drawItems( painter, innerRect, map );
+        renderCanvasItems( plot, painter, innerRect, map );
 
         painter->restore();
 
@@ -869,6 +1753,52 @@ void QwtPlotRenderer::renderCanvas( const QwtPlot *plot,
     }
 }
 
+/*!
+   Render the items of the canvas
+
+   On vector devices the paint operations are simplified
+   according to vectorResolution().
+
+   \param plot Plot widget
+   \param painter Painter
+   \param canvasRect Canvas rectangle
+   \param map Maps mapping between plot and paint device coordinates
+
+   \sa setVectorResolution(), QwtPlot::drawItems()
+*/
+void QwtPlotRenderer::renderCanvasItems( const QwtPlot *plot,
+    QPainter *painter, const QRectF &canvasRect,
+    const QwtScaleMap *map ) const
+{
+    if ( d_data->vectorResolution <= 0 || !qwtIsVectorDevice( painter ) )
+    {
+        plot->drawItems( painter, canvasRect, map );
+        return;
+    }
+
+    painter->save();
+
+    QwtPlotExportDevice exportDevice( painter, d_data->vectorResolution );
+
+    QPainter exportPainter( &exportDevice );
+    exportPainter.setPen( painter->pen() );
+    exportPainter.setBrush( painter->brush() );
+    exportPainter.setFont( painter->font() );
+    exportPainter.setRenderHints( painter->renderHints() );
+    exportPainter.setLayoutDirection( painter->layoutDirection() );
+    exportPainter.setTransform( painter->transform() );
+
+    if ( painter->hasClipping() )
+        exportPainter.setClipPath( painter->clipPath() );
+
+    plot->drawItems( &exportPainter, canvasRect, map );
+
+    exportPainter.end();
+    exportDevice.flush();
+
+    painter->restore();
+}
+
 /*!
    Calculated the scale maps for rendering the canvas
 
@@ -108,6 +108,9 @@ public:
     void setLayoutFlags( LayoutFlags flags );
     LayoutFlags layoutFlags() const;
 
+    void setVectorResolution( int dpi );
+    int vectorResolution() const;
+
     void renderDocument( QwtPlot *, const QString &fileName,
         const QSizeF &sizeMM, int resolution = 85 );
 
@@ -159,6 +162,9 @@ private:
     bool updateCanvasMargins( QwtPlot *,
         const QRectF &, const QwtScaleMap maps[] ) const;
 
+    void renderCanvasItems( const QwtPlot *, QPainter *,
+        const QRectF &canvasRect, const QwtScaleMap* maps ) const;
+
 private:
     class PrivateData;
     PrivateData *d_data;
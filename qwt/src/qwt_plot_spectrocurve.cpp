@@ -12,6 +12,67 @@
 #include "qwt_scale_map.h"
 #include "qwt_painter.h"
 #include <qpainter.h>
+#include <qimage.h>
+#include <qhash.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+#include <typeinfo>
+
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtSpectroDotsCommand
+{
+public:
+    const QwtSeriesData<QwtPoint3D> *series;
+    int from;
+    int to;
+
+    const QwtColorMap *colorMap;
+    QwtInterval colorRange;
+
+    // NULL for QwtColorMap::RGB
+    const QRgb *colorTable;
+};
+
+static void qwtRenderSpectroDots(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSpectroDotsCommand command, const QPoint &pos, QImage *image )
+{
+    QRgb *bits = reinterpret_cast<QRgb *>( image->bits() );
+
+    const int w = image->width();
+    const int h = image->height();
+
+    const int x0 = pos.x();
+    const int y0 = pos.y();
+
+    for ( int i = command.from; i <= command.to; i++ )
+    {
+        const QwtPoint3D sample = command.series->sample( i );
+
+        const int x = qRound( xMap.transform( sample.x() ) ) - x0;
+        const int y = qRound( yMap.transform( sample.y() ) ) - y0;
+
+        if ( x >= 0 && x < w && y >= 0 && y < h )
+        {
+            QRgb rgb;
+            if ( command.colorTable )
+            {
+                const uint index = command.colorMap->colorIndex(
+                    256, command.colorRange, sample.z() );
+
+                rgb = command.colorTable[index];
+            }
+            else
+            {
+                rgb = command.colorMap->rgb( command.colorRange, sample.z() );
+            }
+
+            bits[ y * w + x ] = rgb;
+        }
+    }
+}
 
 class QwtPlotSpectroCurve::PrivateData
 {
@@ -69,6 +130,7 @@ void QwtPlotSpectroCurve::init()
 {
     setItemAttribute( QwtPlotItem::Legend );
     setItemAttribute( QwtPlotItem::AutoScale );
+    setConcurrentRenderingType( typeid( QwtPlotSpectroCurve ) );
 
     d_data = new PrivateData;
     setData( new QwtPoint3DSeriesData() );
@@ -274,12 +336,85 @@ void QwtPlotSpectroCurve::drawDots( QPainter *painter,
 
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
+    if ( ( d_data->paintAttributes & ImageBuffer ) && doAlign
+        && d_data->penWidth <= 1.0
+        && !painter->testRenderHint( QPainter::Antialiasing ) )
+    {
+        const QImage image = renderImage(
+            xMap, yMap, canvasRect.toAlignedRect(), from, to );
+
+        painter->drawImage( canvasRect.toAlignedRect(), image );
+        return;
+    }
+
     const QwtColorMap::Format format = d_data->colorMap->format();
     if ( format == QwtColorMap::Indexed )
         d_data->colorTable = d_data->colorMap->colorTable256();
 
     const QwtSeriesData<QwtPoint3D> *series = data();
 
+    if ( d_data->paintAttributes & GroupColors )
+    {
+        // buckets of points in the order of the first appearance of a color
+        QVector<QRgb> colors;
+        QVector<QPolygonF> buckets;
+        QHash<QRgb, int> bucketIndex;
+
+        for ( int i = from; i <= to; i++ )
+        {
+            const QwtPoint3D sample = series->sample( i );
+
+            double xi = xMap.transform( sample.x() );
+            double yi = yMap.transform( sample.y() );
+            if ( doAlign )
+            {
+                xi = qRound( xi );
+                yi = qRound( yi );
+            }
+
+            if ( d_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints )
+            {
+                if ( !canvasRect.contains( xi, yi ) )
+                    continue;
+            }
+
+            QRgb rgb;
+            if ( format == QwtColorMap::RGB )
+            {
+                rgb = d_data->colorMap->rgb( d_data->colorRange, sample.z() );
+            }
+            else
+            {
+                const unsigned char index = d_data->colorMap->colorIndex(
+                    256, d_data->colorRange, sample.z() );
+
+                rgb = d_data->colorTable[index];
+            }
+
+            QHash<QRgb, int>::const_iterator it = bucketIndex.constFind( rgb );
+            if ( it == bucketIndex.constEnd() )
+            {
+                it = bucketIndex.insert( rgb, buckets.size() );
+
+                colors += rgb;
+                buckets += QPolygonF();
+            }
+
+            buckets[ it.value() ] += QPointF( xi, yi );
+        }
+
+        for ( int i = 0; i < buckets.size(); i++ )
+        {
+            painter->setPen( QPen( QColor::fromRgba( colors[i] ),
+                d_data->penWidth ) );
+
+            QwtPainter::drawPoints( painter, buckets[i] );
+        }
+
+        d_data->colorTable.clear();
+        return;
+    }
+
     for ( int i = from; i <= to; i++ )
     {
         const QwtPoint3D sample = series->sample( i );
@@ -319,3 +454,89 @@ void QwtPlotSpectroCurve::drawDots( QPainter *painter,
 
     d_data->colorTable.clear();
 }
+
+/*!
+  Render a subset of the points into an image
+
+  Each point is mapped to exactly one pixel, that is set to the color
+  of the point. The image is rendered in renderThreadCount() threads,
+  each of them processing a contiguous range of the samples.
+
+  \param xMap Maps x-values into pixel coordinates.
+  \param yMap Maps y-values into pixel coordinates.
+  \param rect Rectangle of the image in paint device coordinates
+  \param from Index of the first sample to be painted
+  \param to Index of the last sample to be painted
+
+  \return ARGB32 image with a transparent background
+  \sa drawDots(), ImageBuffer
+*/
+QImage QwtPlotSpectroCurve::renderImage(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRect &rect, int from, int to ) const
+{
+    QImage image( rect.size(), QImage::Format_ARGB32 );
+    image.fill( Qt::transparent );
+
+    if ( image.isNull() || from > to )
+        return image;
+
+    // computing the table once for all threads
+
+    QVector<QRgb> colorTable;
+    if ( d_data->colorMap->format() == QwtColorMap::Indexed )
+        colorTable = d_data->colorMap->colorTable256();
+
+    QwtSpectroDotsCommand command;
+    command.series = data();
+    command.colorMap = d_data->colorMap;
+    command.colorRange = d_data->colorRange;
+    command.colorTable = colorTable.isEmpty() ? NULL : colorTable.constData();
+
+    const QPoint pos = rect.topLeft();
+
+#if !defined(QT_NO_QFUTURE)
+    uint numThreads = renderThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    if ( numThreads <= 0 )
+        numThreads = 1;
+
+    const int numPoints = ( to - from + 1 ) / numThreads;
+
+    QList< QFuture<void> > futures;
+    for ( uint i = 0; i < numThreads; i++ )
+    {
+        const int index0 = from + i * numPoints;
+        if ( i == numThreads - 1 )
+        {
+            command.from = index0;
+            command.to = to;
+
+            qwtRenderSpectroDots( xMap, yMap, command, pos, &image );
+        }
+        else
+        {
+            command.from = index0;
+            command.to = index0 + numPoints - 1;
+
+            futures += QtConcurrent::run( &qwtRenderSpectroDots,
+                xMap, yMap, command, pos, &image );
+        }
+    }
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    command.from = from;
+    command.to = to;
+
+    qwtRenderSpectroDots( xMap, yMap, command, pos, &image );
+#endif
+
+    const size_t numSamples = to - from + 1;
+    addPaintStatistics( numSamples, numSamples );
+
+    return image;
+}
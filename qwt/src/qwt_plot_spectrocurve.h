@@ -16,6 +16,7 @@
 
 class QwtSymbol;
 class QwtColorMap;
+class QImage;
 
 /*!
     \brief Curve that displays 3D points as dots, where the z coordinate is
@@ -29,7 +30,34 @@ public:
     enum PaintAttribute
     {
         //! Clip points outside the canvas rectangle
-        ClipPoints = 1
+        ClipPoints = 1,
+
+        /*!
+          Render the dots into an ARGB32 image, that is painted to the
+          canvas afterwards. The pixels of the image are set directly
+          from a precomputed color table, what is significantly faster
+          than painting each dot with its own pen.
+          The image is rendered in renderThreadCount() threads.
+
+          Has only an effect, when painting to a paint device in integer
+          coordinates ( f.e. all widgets on screen ) without antialiasing
+          and a penWidth() <= 1. Overlapping semi transparent dots are
+          not blended.
+
+          \sa QwtPlotItem::renderThreadCount()
+         */
+        ImageBuffer = 2,
+
+        /*!
+          Sort the dots into buckets of the same color and paint
+          each bucket with one pen and one call of
+          QwtPainter::drawPoints().
+
+          As the dots are not painted in the order of the samples
+          overlapping dots might be displayed differently.
+          When ImageBuffer is enabled and applicable it takes precedence.
+         */
+        GroupColors = 4
     };
 
     //! Paint attributes
@@ -67,6 +95,10 @@ protected:
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect, int from, int to ) const;
 
+    virtual QImage renderImage(
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRect &rect, int from, int to ) const;
+
 private:
     void init();
 
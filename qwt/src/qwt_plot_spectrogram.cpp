@@ -523,6 +523,10 @@ QImage QwtPlotSpectrogram::renderImage(
 
     d_data->data->discardRaster();
 
+    const size_t numPixels = 
+        static_cast<size_t>( imageSize.width() ) * imageSize.height();
+    addPaintStatistics( numPixels, numPixels );
+
     return image;
 }
 
@@ -237,6 +237,37 @@ void QwtPlotTextLabel::draw( QPainter *painter,
     }
 }
 
+/*!
+   \brief Calculate the area on the canvas, that is painted by the label
+
+   \param xMap x Scale Map
+   \param yMap y Scale Map
+   \param canvasRect Contents rectangle of the canvas in painter coordinates
+
+   \return Bounding rectangle of the text including its border
+   \sa textRect(), QwtPlotItem::paintBoundingRect()
+ */
+QRectF QwtPlotTextLabel::paintBoundingRect( const QwtScaleMap &xMap,
+    const QwtScaleMap &yMap, const QRectF &canvasRect ) const
+{
+    Q_UNUSED( xMap );
+    Q_UNUSED( yMap );
+
+    if ( d_data->text.isEmpty() )
+        return QRectF();
+
+    const int m = d_data->margin;
+
+    const QRectF rect = textRect( canvasRect.adjusted( m, m, -m, -m ),
+        canvasTextSize( d_data->text ) );
+
+    qreal pw = 1.0;
+    if ( d_data->text.borderPen().style() != Qt::NoPen )
+        pw += qMax( d_data->text.borderPen().widthF(), qreal( 1.0 ) );
+
+    return rect.adjusted( -pw, -pw, pw, pw );
+}
+
 /*!
    \brief Align the text label
 
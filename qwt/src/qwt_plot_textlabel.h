@@ -60,6 +60,9 @@ public:
 
     virtual QRectF textRect( const QRectF &, const QSizeF & ) const;
 
+    virtual QRectF paintBoundingRect( const QwtScaleMap &,
+        const QwtScaleMap &, const QRectF &canvasRect ) const;
+
 protected:
     virtual void draw( QPainter *,
         const QwtScaleMap &, const QwtScaleMap &,
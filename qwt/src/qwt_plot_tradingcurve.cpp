@@ -12,6 +12,9 @@
 #include "qwt_clipper.h"
 #include "qwt_painter.h"
 #include <qpainter.h>
+#include <qmath.h>
+#include <qdatastream.h>
+#include <typeinfo>
 
 static inline bool qwtIsSampleInside( const QwtOHLCSample &sample,
     double tMin, double tMax, double vMin, double vMax )
@@ -25,6 +28,118 @@ static inline bool qwtIsSampleInside( const QwtOHLCSample &sample,
     return !isOffScreen;
 }
 
+static inline void qwtMergeSample( QwtOHLCSample &s1, 
+    const QwtOHLCSample &s2 )
+{
+    s1.high = qMax( s1.high, s2.high );
+    s1.low = qMin( s1.low, s2.low );
+    s1.close = s2.close;
+}
+
+static inline void qwtAggregateSample( QVector<QwtOHLCSample> &samples,
+    int &bucket, const QwtOHLCSample &sample, 
+    const QwtScaleMap &timeMap, double origin, double width )
+{
+    const int b = qFloor( ( timeMap.transform( sample.time ) - origin ) / width );
+
+    if ( !samples.isEmpty() && b == bucket )
+    {
+        // an aggregate is displayed in the center of its bucket,
+        // while a single sample keeps its position
+
+        QwtOHLCSample &aggregate = samples.last();
+
+        qwtMergeSample( aggregate, sample );
+        aggregate.time = timeMap.invTransform( origin + ( b + 0.5 ) * width );
+    }
+    else
+    {
+        bucket = b;
+        samples += sample;
+    }
+}
+
+class QwtTradingLevels
+{
+public:
+    QwtTradingLevels():
+        isValid( false )
+    {
+    }
+
+    void reset()
+    {
+        isValid = false;
+
+        samples.clear();
+        maxSpans.clear();
+    }
+
+    void update( const QwtSeriesData<QwtOHLCSample> *series )
+    {
+        if ( isValid )
+            return;
+
+        reset();
+
+        QVector<QwtOHLCSample> level;
+        QVector<double> lastTimes;
+
+        const int numSamples = static_cast<int>( series->size() );
+
+        // level 0 aggregates pairs of the original samples
+
+        level.resize( numSamples / 2 );
+        lastTimes.resize( level.size() );
+
+        double maxSpan = 0.0;
+        for ( int i = 0; i < level.size(); i++ )
+        {
+            QwtOHLCSample s = series->sample( 2 * i );
+            const QwtOHLCSample s2 = series->sample( 2 * i + 1 );
+
+            qwtMergeSample( s, s2 );
+
+            level[i] = s;
+            lastTimes[i] = s2.time;
+
+            maxSpan = qMax( maxSpan, s2.time - s.time );
+        }
+
+        while ( level.size() > 1 )
+        {
+            samples += level;
+            maxSpans += maxSpan;
+
+            const QVector<QwtOHLCSample> &prev = samples.last();
+            const QVector<double> prevLastTimes = lastTimes;
+
+            level.resize( prev.size() / 2 );
+            lastTimes.resize( level.size() );
+
+            maxSpan = 0.0;
+            for ( int i = 0; i < level.size(); i++ )
+            {
+                QwtOHLCSample s = prev[2 * i];
+                qwtMergeSample( s, prev[2 * i + 1] );
+
+                level[i] = s;
+                lastTimes[i] = prevLastTimes[2 * i + 1];
+
+                maxSpan = qMax( maxSpan, lastTimes[i] - s.time );
+            }
+        }
+
+        isValid = true;
+    }
+
+    bool isValid;
+
+    // samples[i] aggregates 2^(i+1) samples
+    QVector< QVector<QwtOHLCSample> > samples;
+    QVector<double> maxSpans;
+};
+
 class QwtPlotTradingCurve::PrivateData
 {
 public:
@@ -48,6 +163,8 @@ public:
     QBrush symbolBrush[2]; // Increasing/Decreasing
 
     QwtPlotTradingCurve::PaintAttributes paintAttributes;
+
+    mutable QwtTradingLevels levels;
 };
 
 /*!
@@ -81,6 +198,7 @@ void QwtPlotTradingCurve::init()
 {
     setItemAttribute( QwtPlotItem::Legend, true );
     setItemAttribute( QwtPlotItem::AutoScale, true );
+    setConcurrentRenderingType( typeid( QwtPlotTradingCurve ) );
 
     d_data = new PrivateData;
     setData( new QwtTradingChartData() );
@@ -108,6 +226,9 @@ void QwtPlotTradingCurve::setPaintAttribute(
         d_data->paintAttributes |= attribute;
     else
         d_data->paintAttributes &= ~attribute;
+
+    if ( attribute == CacheAggregates && !on )
+        d_data->levels.reset();
 }
 
 /*!
@@ -455,9 +576,21 @@ void QwtPlotTradingCurve::drawSymbols( QPainter *painter,
 
     painter->setPen( pen );
 
+    const bool doAggregate = d_data->paintAttributes & AggregateSamples;
+
+    QVector<QwtOHLCSample> aggregated;
+    if ( doAggregate )
+    {
+        aggregated = aggregatedSamples( *timeMap, 
+            qMax( symbolWidth, 1.0 ), from, to );
+
+        from = 0;
+        to = aggregated.size() - 1;
+    }
+
     for ( int i = from; i <= to; i++ )
     {
-        const QwtOHLCSample s = sample( i );
+        const QwtOHLCSample s = doAggregate ? aggregated[i] : sample( i );
 
         if ( !doClip || qwtIsSampleInside( s, tMin, tMax, vMin, vMax ) )
         {
@@ -511,6 +644,92 @@ void QwtPlotTradingCurve::drawSymbols( QPainter *painter,
     }
 }
 
+/*!
+  Merge consecutive samples, that are mapped into the same interval
+
+  The intervals are aligned to the position of the first sample,
+  so that they don't change, when the canvas is scrolled.
+
+  \param timeMap Map for the time coordinates
+  \param width Width of an interval in paint device coordinates
+  \param from Index of the first sample
+  \param to Index of the last sample
+
+  \return Aggregated samples, where the time is the center 
+          of the interval. Samples, that are the only one
+          in their interval, keep their time.
+  \sa AggregateSamples, CacheAggregates
+*/
+QVector<QwtOHLCSample> QwtPlotTradingCurve::aggregatedSamples( 
+    const QwtScaleMap &timeMap, double width, int from, int to ) const
+{
+    QVector<QwtOHLCSample> aggregated;
+
+    const QwtSeriesData<QwtOHLCSample> *series = data();
+
+    const double origin = timeMap.transform( series->sample( 0 ).time );
+
+    const int lastIndex = to;
+    const int numSamples = to - from + 1;
+
+    const QwtOHLCSample *levelSamples = NULL;
+    int shift = 0;
+
+    if ( ( d_data->paintAttributes & CacheAggregates ) 
+        && timeMap.transformation() == NULL && timeMap.s1() != timeMap.s2() )
+    {
+        d_data->levels.update( series );
+
+        const double scale = 
+            qAbs( ( timeMap.p2() - timeMap.p1() ) / ( timeMap.s2() - timeMap.s1() ) );
+
+        const QVector<double> &maxSpans = d_data->levels.maxSpans;
+        for ( int level = maxSpans.size() - 1; level >= 0; level-- )
+        {
+            if ( maxSpans[level] * scale <= 1.0 )
+            {
+                levelSamples = d_data->levels.samples[level].constData();
+                shift = level + 1;
+
+                from = from >> shift;
+                to = qMin( ( ( to + 1 ) >> shift ) - 1, 
+                    d_data->levels.samples[level].size() - 1 );
+
+                break;
+            }
+        }
+    }
+
+    int bucket = 0;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QwtOHLCSample s = levelSamples ? levelSamples[i] : series->sample( i );
+        qwtAggregateSample( aggregated, bucket, s, timeMap, origin, width );
+    }
+
+    // samples, that are not part of a complete aggregate of the level
+    for ( int i = ( to + 1 ) << shift; shift > 0 && i <= lastIndex; i++ )
+    {
+        qwtAggregateSample( aggregated, bucket, 
+            series->sample( i ), timeMap, origin, width );
+    }
+
+    addPaintStatistics( numSamples, aggregated.size() );
+
+    return aggregated;
+}
+
+/*!
+  \brief Invalidate the cached aggregation levels and call itemChanged()
+  \sa CacheAggregates
+ */
+void QwtPlotTradingCurve::dataChanged()
+{
+    d_data->levels.reset();
+    QwtPlotSeriesItem::dataChanged();
+}
+
 /*!
   \brief Draw a symbol for a symbol style >= UserSymbol
 
@@ -640,6 +859,33 @@ QwtGraphic QwtPlotTradingCurve::legendIcon( int index,
     return defaultIcon( d_data->symbolPen.color(), size );
 }
 
+/*!
+  \return Key including all attributes, that have an effect on legendIcon()
+
+  \param index Index of the legend entry
+                ( usually there is only one )
+  \param size Icon size
+
+  \note For derived classes an empty key is returned, as they might
+        reimplement legendIcon()
+  \sa QwtPlotItem::legendIconKey(), QwtPlotItem::legendData()
+*/
+QByteArray QwtPlotTradingCurve::legendIconKey( int index,
+    const QSizeF &size ) const
+{
+    Q_UNUSED( index );
+
+    if ( size.isEmpty() || typeid( *this ) != typeid( QwtPlotTradingCurve ) )
+        return QByteArray();
+
+    QByteArray key;
+
+    QDataStream stream( &key, QIODevice::WriteOnly );
+    stream << rtti() << size << d_data->symbolPen.color();
+
+    return key;
+}
+
 /*!
   Calculate the symbol width in paint coordinates
 
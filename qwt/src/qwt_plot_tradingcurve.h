@@ -95,7 +95,36 @@ public:
     enum PaintAttribute
     {
         //! Check if a symbol is on the plot canvas before painting it.
-        ClipSymbols   = 0x01
+        ClipSymbols   = 0x01,
+
+        /*!
+          Merge consecutive samples, that are mapped into the same 
+          interval of the width of a symbol, into one sample:
+          the open value of the first, the close value of the last,
+          the minimum of the lows and the maximum of the highs.
+
+          The number of symbols to be painted is limited by 
+          the size of the plot canvas then.
+
+          \note The samples need to be in increasing order of time
+          \sa scaledSymbolWidth()
+         */
+        AggregateSamples = 0x02,
+
+        /*!
+          Precalculate levels, where each sample is the aggregation
+          of 2, 4, 8 ... consecutive samples. When AggregateSamples
+          is enabled the coarsest level, where no aggregated sample
+          covers more than a pixel, is used as input for the aggregation.
+
+          The levels are calculated, when being needed for the first time
+          and are cached until the data has been changed.
+          The memory for the levels is about the size of the samples.
+
+          \note Only effective for linear scales
+          \sa AggregateSamples
+         */
+        CacheAggregates = 0x04
     };
 
     //! Paint attributes
@@ -141,6 +170,7 @@ public:
     virtual QRectF boundingRect() const;
 
     virtual QwtGraphic legendIcon( int index, const QSizeF & ) const;
+    virtual QByteArray legendIconKey( int index, const QSizeF & ) const;
 
 protected:
 
@@ -164,7 +194,12 @@ protected:
         const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QRectF &canvasRect ) const;
 
+    virtual void dataChanged();
+
 private:
+    QVector<QwtOHLCSample> aggregatedSamples( 
+        const QwtScaleMap &timeMap, double width, int from, int to ) const;
+
     class PrivateData;
     PrivateData *d_data;
 };
@@ -55,7 +55,10 @@ QwtPointArrayData::QwtPointArrayData( const double *x,
 QRectF QwtPointArrayData::boundingRect() const
 {
     if ( d_boundingRect.width() < 0 )
-        d_boundingRect = qwtBoundingRect( *this );
+    {
+        d_boundingRect = qwtBoundingRect(
+            d_x.constData(), d_y.constData(), size() );
+    }
 
     return d_boundingRect;
 }
@@ -121,7 +124,7 @@ QwtCPointerData::QwtCPointerData(
 QRectF QwtCPointerData::boundingRect() const
 {
     if ( d_boundingRect.width() < 0 )
-        d_boundingRect = qwtBoundingRect( *this );
+        d_boundingRect = qwtBoundingRect( d_x, d_y, d_size );
 
     return d_boundingRect;
 }
@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include "qwt_point_mapper.h"
+#include "qwt_clipper.h"
 #include "qwt_scale_map.h"
 #include "qwt_pixel_matrix.h"
 #include <qpolygon.h>
@@ -472,6 +473,32 @@ static inline QPolygonF qwtToPolylineFilteredF(
         xMap, yMap, series, from, to, round );
 } 
 
+// Mapping points and passing them to a clipper, 
+// without storing them in a temporary buffer
+
+template<class Round>
+static inline void qwtToClipper( 
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to, 
+    bool weedOut, Round round, QwtStreamingClipper &clipper )
+{
+    QPointF lastPoint;
+
+    for ( int i = from; i <= to; i++ )
+    {
+        const QPointF sample = series->sample( i );
+
+        const QPointF point( round( xMap.transform( sample.x() ) ),
+            round( yMap.transform( sample.y() ) ) );
+
+        if ( weedOut && i > from && point == lastPoint )
+            continue;
+
+        clipper.addPoint( point );
+        lastPoint = point;
+    }
+}
+
 template<class Polygon, class Point>
 static inline Polygon qwtToPointsFiltered(
     const QRectF &boundingRect,
@@ -679,6 +706,53 @@ QPolygonF QwtPointMapper::toPolygonF(
     return polyline;
 }
 
+/*!
+  \brief Translate a series of points and pass them to a clipper
+
+  The points are passed one by one to the clipper, so that the 
+  complete series never needs to be stored in a temporary buffer.
+  The flags are respected like in toPolygonF().
+
+  \param xMap x map
+  \param yMap y map
+  \param series Series of points to be mapped
+  \param from Index of the first point to be painted
+  \param to Index of the last point to be painted
+  \param clipper Clipper, where QwtStreamingClipper::begin() 
+                 has been called before.
+
+  \sa toPolygonF(), QwtStreamingClipper
+*/
+void QwtPointMapper::toClippedPolygonF(
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QwtSeriesData<QPointF> *series, int from, int to,
+    QwtStreamingClipper &clipper ) const
+{
+    if ( d_data->flags & RoundPoints )
+    {
+        if ( d_data->flags & WeedOutIntermediatePoints )
+        {
+            // the weeding algorithm reduces the number of points
+            // significantly before passing them to the clipper
+
+            const QPolygonF polyline = qwtMapPointsQuad<QPolygonF, QPointF>( 
+                xMap, yMap, series, from, to );
+
+            clipper.addPoints( polyline.constData(), polyline.size() );
+        }
+        else
+        {
+            qwtToClipper( xMap, yMap, series, from, to,
+                d_data->flags & WeedOutPoints, QwtRoundF(), clipper );
+        }
+    }
+    else
+    {
+        qwtToClipper( xMap, yMap, series, from, to,
+            d_data->flags & WeedOutPoints, QwtNoRoundF(), clipper );
+    }
+}
+
 /*!
   \brief Translate a series of points into a QPolygon
 
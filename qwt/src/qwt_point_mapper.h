@@ -15,6 +15,7 @@
 #include <qimage.h>
 
 class QwtScaleMap;
+class QwtStreamingClipper;
 class QPolygonF;
 class QPolygon;
 
@@ -89,6 +90,10 @@ public:
     QPolygon toPolygon( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
+    void toClippedPolygonF( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QwtSeriesData<QPointF> *series, int from, int to,
+        QwtStreamingClipper & ) const;
+
     QPolygon toPoints( const QwtScaleMap &xMap, const QwtScaleMap &yMap,
         const QwtSeriesData<QPointF> *series, int from, int to ) const;
 
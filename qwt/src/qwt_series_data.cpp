@@ -9,6 +9,7 @@
 
 #include "qwt_series_data.h"
 #include "qwt_math.h"
+#include <qnumeric.h>
 
 static inline QRectF qwtBoundingRect( const QPointF &sample )
 {
@@ -56,6 +57,54 @@ static inline QRectF qwtBoundingRect( const QwtOHLCSample &sample )
     return QRectF( interval.minValue(), sample.time, interval.width(), 0.0 );
 }
 
+/*
+  The min/max loops below work with 4 independent accumulators,
+  so that the compiler is able to pipeline/vectorize them.
+  Comparisons with NaN are false, so NaN values are ignored.
+ */
+
+static inline void qwtUpdateMin( double value, double &minValue )
+{
+    minValue = ( value < minValue ) ? value : minValue;
+}
+
+static inline void qwtUpdateMax( double value, double &maxValue )
+{
+    maxValue = ( value > maxValue ) ? value : maxValue;
+}
+
+static bool qwtMinMax( const double *values, size_t size,
+    double &minValue, double &maxValue )
+{
+    double min[4], max[4];
+    for ( int k = 0; k < 4; k++ )
+    {
+        min[k] = qInf();
+        max[k] = -qInf();
+    }
+
+    size_t i = 0;
+    for ( ; i + 4 <= size; i += 4 )
+    {
+        for ( int k = 0; k < 4; k++ )
+        {
+            qwtUpdateMin( values[i + k], min[k] );
+            qwtUpdateMax( values[i + k], max[k] );
+        }
+    }
+
+    for ( ; i < size; i++ )
+    {
+        qwtUpdateMin( values[i], min[0] );
+        qwtUpdateMax( values[i], max[0] );
+    }
+
+    minValue = qMin( qMin( min[0], min[1] ), qMin( min[2], min[3] ) );
+    maxValue = qMax( qMax( max[0], max[1] ), qMax( max[2], max[3] ) );
+
+    return minValue <= maxValue;
+}
+
 /*!
   \brief Calculate the bounding rectangle of a series subset
 
@@ -110,6 +159,87 @@ QRectF qwtBoundingRectT(
     return boundingRect;
 }
 
+/*!
+  \brief Calculate the bounding rectangle of points stored in 2 arrays
+
+  Fast implementation for contiguous memory, scanning
+  the x and y coordinates in separate loops.
+  NaN coordinates are ignored.
+
+  \param xData Array of x coordinates
+  \param yData Array of y coordinates
+  \param size Number of points
+
+  \return Bounding rectangle
+*/
+QRectF qwtBoundingRect(
+    const double *xData, const double *yData, size_t size )
+{
+    double xMin, xMax, yMin, yMax;
+
+    if ( !qwtMinMax( xData, size, xMin, xMax )
+        || !qwtMinMax( yData, size, yMin, yMax ) )
+    {
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+    }
+
+    return QRectF( xMin, yMin, xMax - xMin, yMax - yMin );
+}
+
+/*!
+  \brief Calculate the bounding rectangle of an array of points
+
+  Fast implementation for contiguous memory. NaN coordinates are ignored.
+
+  \param points Array of points
+  \param size Number of points
+
+  \return Bounding rectangle
+*/
+QRectF qwtBoundingRect( const QPointF *points, size_t size )
+{
+    double xMin[2], xMax[2], yMin[2], yMax[2];
+    for ( int k = 0; k < 2; k++ )
+    {
+        xMin[k] = yMin[k] = qInf();
+        xMax[k] = yMax[k] = -qInf();
+    }
+
+    size_t i = 0;
+    for ( ; i + 2 <= size; i += 2 )
+    {
+        for ( int k = 0; k < 2; k++ )
+        {
+            const QPointF &p = points[i + k];
+
+            qwtUpdateMin( p.x(), xMin[k] );
+            qwtUpdateMax( p.x(), xMax[k] );
+            qwtUpdateMin( p.y(), yMin[k] );
+            qwtUpdateMax( p.y(), yMax[k] );
+        }
+    }
+
+    if ( i < size )
+    {
+        const QPointF &p = points[i];
+
+        qwtUpdateMin( p.x(), xMin[0] );
+        qwtUpdateMax( p.x(), xMax[0] );
+        qwtUpdateMin( p.y(), yMin[0] );
+        qwtUpdateMax( p.y(), yMax[0] );
+    }
+
+    const double x1 = qMin( xMin[0], xMin[1] );
+    const double x2 = qMax( xMax[0], xMax[1] );
+    const double y1 = qMin( yMin[0], yMin[1] );
+    const double y2 = qMax( yMax[0], yMax[1] );
+
+    if ( x1 > x2 || y1 > y2 )
+        return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+    return QRectF( x1, y1, x2 - x1, y2 - y1 );
+}
+
 /*!
   \brief Calculate the bounding rectangle of a series subset
 
@@ -236,7 +366,10 @@ QwtPointSeriesData::QwtPointSeriesData(
 QRectF QwtPointSeriesData::boundingRect() const
 {
     if ( d_boundingRect.width() < 0.0 )
-        d_boundingRect = qwtBoundingRect( *this );
+    {
+        d_boundingRect = qwtBoundingRect(
+            d_samples.constData(), d_samples.size() );
+    }
 
     return d_boundingRect;
 }
@@ -73,6 +73,10 @@ public:
        over the samples. For large sets it is recommended to implement
        something faster f.e. by caching the bounding rectangle.
 
+       \note When the QwtPlotItem::ConcurrentBoundingRect attribute
+             of the item is enabled, boundingRect() is called from
+             a worker thread.
+
        \return Bounding rectangle
      */
     virtual QRectF boundingRect() const = 0;
@@ -263,6 +267,11 @@ QWT_EXPORT QRectF qwtBoundingRect(
 QWT_EXPORT QRectF qwtBoundingRect(
     const QwtSeriesData<QwtOHLCSample> &, int from = 0, int to = -1 );
 
+QWT_EXPORT QRectF qwtBoundingRect(
+    const double *xData, const double *yData, size_t size );
+
+QWT_EXPORT QRectF qwtBoundingRect( const QPointF *points, size_t size );
+
 /*!
     Binary search for a sorted series of samples
 
@@ -666,40 +666,50 @@ QPolygonF QwtSplineC1::polygonX( int numPoints, const QPolygonF &points ) const
 
     QPolygonF fittedPoints;
 
-    const QVector<double> m = slopesX( points );
-    if ( m.size() != points.size() )
+    const QVector<QwtSplinePolynom> polynoms = polynomsX( points );
+    if ( polynoms.size() != points.size() - 1 || numPoints < 2 )
         return fittedPoints;
 
-    const QPointF *p = points.constData();
-    const double *s = m.constData();
-
     const double x1 = points.first().x();
     const double x2 = points.last().x();
 
     const double delta = ( x2 - x1 ) / ( numPoints - 1 );
 
-    double x0, y0;
-    QwtSplinePolynom polynom;
+    fittedPoints.resize( numPoints );
+
+    const QPointF *p = points.constData();
+    const QwtSplinePolynom *pn = polynoms.constData();
+    QPointF *fp = fittedPoints.data();
 
-    for ( int i = 0, j = 0; i < numPoints; i++ )
+    // all points of a segment are calculated in one run, with
+    // the coefficients of its polynom kept in local variables
+
+    const int lastSegment = polynoms.size() - 1;
+
+    for ( int i = 0, j = 0; j <= lastSegment; j++ )
     {
-        double x = x1 + i * delta;
-        if ( x > x2 )
-            x = x2;
+        const double x0 = p[j].x();
+        const double y0 = p[j].y();
+        const double xEnd = p[j + 1].x();
+
+        const double c1 = pn[j].c1;
+        const double c2 = pn[j].c2;
+        const double c3 = pn[j].c3;
 
-        if ( i == 0 || x > p[j + 1].x() )
+        for ( ; i < numPoints; i++ )
         {
-            while ( x > p[j + 1].x() )
-                j++;
+            double x = x1 + i * delta;
+            if ( x > x2 )
+                x = x2;
 
-            polynom = QwtSplinePolynom::fromSlopes( p[j], s[j], p[j + 1], s[j + 1] );
+            if ( x > xEnd && j < lastSegment )
+                break;
 
-            x0 = p[j].x();
-            y0 = p[j].y();
-        }
+            const double dx = x - x0;
 
-        const double y = y0 + polynom.value( x - x0 );
-        fittedPoints += QPointF( x, y );
+            fp[i].rx() = x;
+            fp[i].ry() = y0 + ( ( c3 * dx + c2 ) * dx + c1 ) * dx;
+        }
     }
 
     return fittedPoints;
@@ -713,13 +723,89 @@ QVector<QwtSplinePolynom> QwtSplineC1::polynomsX( const QPolygonF &points ) cons
     if ( m.size() < 2 )
         return polynoms;
 
+    polynoms.resize( m.size() - 1 );
+
+    const QPointF *p = points.constData();
+    const double *s = m.constData();
+    QwtSplinePolynom *pn = polynoms.data();
+
     for ( int i = 1; i < m.size(); i++ )
+        pn[i-1] = QwtSplinePolynom::fromSlopes( p[i-1], s[i-1], p[i], s[i] );
+
+    return polynoms;
+}
+
+/*!
+  \brief Interpolate the spline for a series of x coordinates
+
+  The polynoms of all segments are calculated once and the 
+  values are evaluated in one pass over the x coordinates.
+  Values outside of the interval of the control points
+  are extrapolated from the first/last polynom.
+
+  \param x x coordinates in increasing order
+  \param points Control points
+
+  \return Interpolated values for x. In case of an invalid spline
+          an empty vector is returned. For 2 control points the
+          values are on the line through them.
+ */
+QVector<double> QwtSplineC1::valuesX( const QVector<double> &x,
+    const QPolygonF &points ) const
+{
+    QVector<double> values;
+
+    if ( points.size() < 2 )
+        return values;
+
+    QVector<QwtSplinePolynom> polynoms;
+    if ( points.size() == 2 )
     {
-        polynoms += QwtSplinePolynom::fromSlopes( 
-            points[i-1], m[i-1], points[i], m[i] );
+        // a line, like in polygonX() and painterPath()
+        const QPointF &p1 = points[0];
+        const QPointF &p2 = points[1];
+
+        const double slope = ( p2.y() - p1.y() ) / ( p2.x() - p1.x() );
+        polynoms += QwtSplinePolynom::fromSlopes( p1, slope, p2, slope );
+    }
+    else
+    {
+        polynoms = polynomsX( points );
     }
 
-    return polynoms;
+    if ( polynoms.size() != points.size() - 1 )
+        return values;
+
+    values.resize( x.size() );
+
+    const QPointF *p = points.constData();
+    const QwtSplinePolynom *pn = polynoms.constData();
+    const double *px = x.constData();
+    double *v = values.data();
+
+    const int lastSegment = polynoms.size() - 1;
+
+    for ( int i = 0, j = 0; j <= lastSegment; j++ )
+    {
+        const double x0 = p[j].x();
+        const double y0 = p[j].y();
+        const double xEnd = p[j + 1].x();
+
+        const double c1 = pn[j].c1;
+        const double c2 = pn[j].c2;
+        const double c3 = pn[j].c3;
+
+        for ( ; i < x.size(); i++ )
+        {
+            if ( px[i] > xEnd && j < lastSegment )
+                break;
+
+            const double dx = px[i] - x0;
+            v[i] = y0 + ( ( c3 * dx + c2 ) * dx + c1 ) * dx;
+        }
+    }
+
+    return values;
 }
 
 QwtSplineC2::QwtSplineC2()
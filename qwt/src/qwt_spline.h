@@ -141,6 +141,9 @@ public:
     virtual QPolygonF polygonX( int numPoints, const QPolygonF & ) const;
     virtual QVector<QwtSplinePolynom> polynomsX( const QPolygonF & ) const;
 
+    virtual QVector<double> valuesX( const QVector<double> &x,
+        const QPolygonF & ) const;
+
 //protected:
     virtual double slopeBegin( const QPolygonF &points, double m1, double m2 ) const;
     virtual double slopeEnd( const QPolygonF &points, double m1, double m2 ) const;
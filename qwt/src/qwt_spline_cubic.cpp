@@ -9,6 +9,7 @@
 
 #include "qwt_spline_cubic.h"
 #include <qdebug.h>
+#include <qmutex.h>
 
 #define SLOPES_INCREMENTAL 0
 #define KAHAN 0
@@ -369,6 +370,64 @@ namespace QwtSplineCubicP
     };
 };
          
+namespace QwtSplineCubicP
+{
+    /*
+      The coefficients p, q of the substituted spline equations
+      depend on the x coordinates and the type of the boundary 
+      condition only. For a fixed x grid they can be reused, when
+      only the y coordinates have been changed.
+     */
+    class Factorization
+    {
+    public:
+        Factorization():
+            type( -1 )
+        {
+        }
+
+        bool matches( int boundaryType, const QPolygonF &points ) const
+        {
+            if ( boundaryType != type || points.size() != x.size() )
+                return false;
+
+            const QPointF *p = points.constData();
+            const double *px = x.constData();
+
+            for ( int i = 0; i < x.size(); i++ )
+            {
+                if ( p[i].x() != px[i] )
+                    return false;
+            }
+
+            return true;
+        }
+
+        void reset( int boundaryType, const QPolygonF &points )
+        {
+            type = boundaryType;
+
+            x.resize( points.size() );
+            for ( int i = 0; i < points.size(); i++ )
+                x[i] = points[i].x();
+
+            eq.clear();
+            v.clear();
+        }
+
+        bool isComplete() const
+        {
+            return !eq.isEmpty() && ( eq.size() == x.size() - 2 );
+        }
+
+        int type;
+        QVector<double> x;
+
+        QVector<Equation2> eq; // r is unused
+        QVector<double> v;
+    };
+};
+
 QDebug operator<<( QDebug debug, const QwtSplineCubicP::Equation2 &eq )
 {
     debug.nospace() << "EQ2(" << eq.p << ", " << eq.q << ", " << eq.r << ")";
@@ -388,6 +447,16 @@ namespace QwtSplineCubicP
     class EquationSystem
     {
     public:
+        EquationSystem():
+            d_factorization( NULL )
+        {
+        }
+
+        void setFactorization( Factorization *factorization )
+        {
+            d_factorization = factorization;
+        }
+
         void setStartCondition( double p, double q, double u, double r )
         {
             d_conditionsEQ[0].setup( p, q, u, r );
@@ -520,27 +589,67 @@ namespace QwtSplineCubicP
             d_eq.resize( n - 2 );
             d_eq[n-3] = eq;
 
+            if ( d_factorization == NULL || !d_factorization->isComplete() )
+                factorize( points, eq );
+
             // eq[i].resolved2( b[i-1] ) => b[i]
 
-            double slope2 = ( points[n-3].y() - points[n-4].y() ) / eq.p;
+            const Equation2 *feq = ( d_factorization != NULL ) 
+                ? d_factorization->eq.constData() : d_feq.constData();
+
+            const double *v = ( d_factorization != NULL ) 
+                ? d_factorization->v.constData() : d_v.constData();
+
+            const QPointF *p = points.constData();
+            Equation2 *eqs = d_eq.data();
+
+            double slope2 = ( p[n-3].y() - p[n-4].y() ) / eq.p;
 
             for ( int i = n - 4; i > 1; i-- )
             {
-                const Equation2 &eq2 = d_eq[i+1];
-                Equation2 &eq1 = d_eq[i];
+                Equation2 &eq1 = eqs[i];
+
+                eq1.p = feq[i].p;
+                eq1.q = feq[i].q;
+
+                const double slope1 = ( p[i].y() - p[i-1].y() ) / eq1.p;
+                eq1.r = 3.0 * ( slope2 - slope1 ) - v[i] * eqs[i+1].r;
+
+                slope2 = slope1;
+            }
+
+            return d_eq[2];
+        }
+
+        void factorize( const QPolygonF &points, const Equation2 &eq )
+        {
+            // the part of substituteSpline, that depends on 
+            // the x coordinates only
+
+            const int n = points.size();
+
+            QVector<Equation2> &feq = d_factorization ? d_factorization->eq : d_feq;
+            QVector<double> &fv = d_factorization ? d_factorization->v : d_v;
+
+            feq.resize( n - 2 );
+            fv.resize( n - 2 );
+
+            feq[n-3] = eq;
+
+            for ( int i = n - 4; i > 1; i-- )
+            {
+                const Equation2 &eq2 = feq[i+1];
+                Equation2 &eq1 = feq[i];
 
                 eq1.p = points[i].x() - points[i-1].x();
-                const double slope1 = ( points[i].y() - points[i-1].y() ) / eq1.p;
 
                 const double v = eq2.p / eq2.q;
 
                 eq1.q = 2.0 * ( eq1.p + eq2.p ) - v * eq2.p;
-                eq1.r = 3.0 * ( slope2 - slope1 ) - v * eq2.r;
+                eq1.r = 0.0;
 
-                slope2 = slope1;
+                fv[i] = v;
             }
-
-            return d_eq[2];
         }
 
         double resolveSpline( const QPolygonF &points, double b1 )
@@ -564,6 +673,10 @@ namespace QwtSplineCubicP
         Equation3 d_conditionsEQ[2];
         QVector<Equation2> d_eq;
         T d_store;
+
+        Factorization *d_factorization;
+        QVector<Equation2> d_feq;
+        QVector<double> d_v;
     };
 
     template <class T>
@@ -896,6 +1009,36 @@ public:
     PrivateData()
     {
     }
+
+    QwtSplineCubicP::Factorization cachedFactorization(
+        int boundaryCondition, const QPolygonF &points )
+    {
+        QMutexLocker locker( &mutex );
+
+        if ( factorization.matches( boundaryCondition, points ) )
+            return factorization;
+
+        QwtSplineCubicP::Factorization f;
+        f.reset( boundaryCondition, points );
+
+        return f;
+    }
+
+    void storeFactorization( const QwtSplineCubicP::Factorization &f )
+    {
+        QMutexLocker locker( &mutex );
+        factorization = f;
+    }
+
+    /*
+      The spline might be used from different threads. So the
+      equations are resolved with a copy of the factorization,
+      that is published to the cache, when it has been completed.
+     */
+    QMutex mutex;
+
+    // coefficients of the last x grid
+    QwtSplineCubicP::Factorization factorization;
 };
 
 QwtSplineCubic::QwtSplineCubic()
@@ -959,11 +1102,20 @@ QVector<double> QwtSplineCubic::slopesX( const QPolygonF &points ) const
     qwtSetupEndEquations( boundaryCondition(), points, 
         boundaryValueBegin(), boundaryValueEnd(), eq );
 
+    Factorization factorization =
+        d_data->cachedFactorization( boundaryCondition(), points );
+
+    const bool isCached = factorization.isComplete();
+
     EquationSystem<SlopeStore> eqs;
+    eqs.setFactorization( &factorization );
     eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
     eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
     eqs.resolve( points );
 
+    if ( !isCached && factorization.isComplete() )
+        d_data->storeFactorization( factorization );
+
     return eqs.store().slopes();
 }
 
@@ -992,11 +1144,20 @@ QVector<double> QwtSplineCubic::curvaturesX( const QPolygonF &points ) const
     qwtSetupEndEquations( boundaryCondition(), points, 
         boundaryValueBegin(), boundaryValueEnd(), eq );
 
+    Factorization factorization =
+        d_data->cachedFactorization( boundaryCondition(), points );
+
+    const bool isCached = factorization.isComplete();
+
     EquationSystem<CurvatureStore> eqs;
+    eqs.setFactorization( &factorization );
     eqs.setStartCondition( eq[0].p, eq[0].q, eq[0].u, eq[0].r );
     eqs.setEndCondition( eq[1].p, eq[1].q, eq[1].u, eq[1].r );
     eqs.resolve( points );
 
+    if ( !isCached && factorization.isComplete() )
+        d_data->storeFactorization( factorization );
+
     return eqs.store().curvatures();
 }
 
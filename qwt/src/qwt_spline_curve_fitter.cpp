@@ -30,6 +30,9 @@ QwtSplineCurveFitter::~QwtSplineCurveFitter()
   The spline needs to be allocated by new and will be deleted
   in the destructor of the fitter.
 
+  \note When modifying the parameters of the spline later
+        invalidate() needs to be called.
+
   \param spline Spline
   \sa spline()
 */
@@ -40,6 +43,8 @@ void QwtSplineCurveFitter::setSpline( QwtSpline *spline )
 
     delete d_spline;
     d_spline = spline;
+
+    invalidate();
 }
 
 /*!
@@ -14,6 +14,8 @@
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qpixmap.h>
+#include <qimage.h>
+#include <qmutex.h>
 #include <qpaintengine.h>
 #include <qmath.h>
 #ifndef QWT_NO_SVG
@@ -828,7 +830,12 @@ public:
     struct PaintCache
     {
         QwtSymbol::CachePolicy policy;
-        QPixmap pixmap;
+
+        // QPixmap can't be used outside of the GUI thread
+        QImage image;
+
+        // the same symbol might be drawn from concurrent render threads
+        QMutex mutex;
 
     } cache;
 };
@@ -1017,6 +1024,7 @@ void QwtSymbol::setGraphic( const QwtGraphic &graphic )
 {
     d_data->style = QwtSymbol::Graphic;
     d_data->graphic.graphic = graphic;
+    d_data->graphic.graphic.optimize();
 }
 
 /*!
@@ -1311,7 +1319,7 @@ void QwtSymbol::drawSymbols( QPainter *painter,
 
     bool useCache = false;
 
-    // Don't use the pixmap, when the paint device
+    // Don't use the cache, when the paint device
     // could generate scalable vectors
 
     if ( QwtPainter::roundingAlignment( painter ) &&
@@ -1391,17 +1399,41 @@ void QwtSymbol::drawSymbols( QPainter *painter,
 
         const QRect rect( 0, 0, br.width(), br.height() );
 
-        if ( d_data->cache.pixmap.isNull() )
+#if QT_VERSION >= 0x050000
+        const qreal pixelRatio = painter->device()->devicePixelRatio();
+#else
+        const qreal pixelRatio = 1.0;
+#endif
+
+        QImage image;
         {
-            d_data->cache.pixmap = QwtPainter::backingStore( NULL, br.size() );
-            d_data->cache.pixmap.fill( Qt::transparent );
+            QMutexLocker locker( &d_data->cache.mutex );
+
+            QImage &cache = d_data->cache.image;
+
+#if QT_VERSION >= 0x050000
+            if ( !cache.isNull() && cache.devicePixelRatio() != pixelRatio )
+                cache = QImage();
+#endif
+
+            if ( cache.isNull() )
+            {
+                cache = QImage( br.size() * pixelRatio,
+                    QImage::Format_ARGB32_Premultiplied );
+#if QT_VERSION >= 0x050000
+                cache.setDevicePixelRatio( pixelRatio );
+#endif
+                cache.fill( 0u );
 
-            QPainter p( &d_data->cache.pixmap );
-            p.setRenderHints( painter->renderHints() );
-            p.translate( -br.topLeft() );
+                QPainter p( &cache );
+                p.setRenderHints( painter->renderHints() );
+                p.translate( -br.topLeft() );
 
-            const QPointF pos( 0.0, 0.0 );
-            renderSymbols( &p, &pos, 1 );
+                const QPointF pos( 0.0, 0.0 );
+                renderSymbols( &p, &pos, 1 );
+            }
+
+            image = cache;
         }
 
         const int dx = br.left();
@@ -1412,7 +1444,7 @@ void QwtSymbol::drawSymbols( QPainter *painter,
             const int left = qRound( points[i].x() ) + dx;
             const int top = qRound( points[i].y() ) + dy;
 
-            painter->drawPixmap( left, top, d_data->cache.pixmap );
+            painter->drawImage( left, top, image );
         }
     }
     else
@@ -1761,7 +1793,7 @@ QRect QwtSymbol::boundingRect() const
 }
 
 /*!
-  Invalidate the cached symbol pixmap
+  Invalidate the cached symbol image
 
   The symbol invalidates its cache, whenever an attribute is changed
   that has an effect ob how to display a symbol. In case of derived
@@ -1773,8 +1805,10 @@ QRect QwtSymbol::boundingRect() const
  */
 void QwtSymbol::invalidateCache()
 {
-    if ( !d_data->cache.pixmap.isNull() )
-        d_data->cache.pixmap = QPixmap();
+    QMutexLocker locker( &d_data->cache.mutex );
+
+    if ( !d_data->cache.image.isNull() )
+        d_data->cache.image = QImage();
 }
 
 /*!
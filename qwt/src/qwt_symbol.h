@@ -148,10 +148,10 @@ public:
 
     enum CachePolicy
     {
-        //! Don't use a pixmap cache
+        //! Don't use an image cache
         NoCache,
 
-        //! Always use a pixmap cache
+        //! Always use an image cache
         Cache,
 
         /*! 
@@ -16,9 +16,12 @@
 #include <qpen.h>
 #include <qbrush.h>
 #include <qpainter.h>
-#include <qapplication.h>
-#include <qdesktopwidget.h>
 #include <qmath.h>
+#if QT_VERSION >= 0x040700
+#include <qstatictext.h>
+#include <qpaintengine.h>
+#include <typeinfo>
+#endif
 
 class QwtTextEngineDict
 {
@@ -164,15 +167,112 @@ public:
 class QwtText::LayoutCache
 {
 public:
+    LayoutCache &operator=( const LayoutCache &other )
+    {
+        font = other.font;
+        textSize = other.textSize;
+
+#if QT_VERSION >= 0x040700
+        /*
+          QStaticText is implicitly shared and lays out itself again,
+          when being painted. To avoid, that copies painted in different
+          threads modify the same data, a copy prepares its own layout.
+         */
+        staticText = QStaticText();
+        staticTextFont = QFont();
+#endif
+        return *this;
+    }
+
     void invalidate()
     {
         textSize = QSizeF();
+#if QT_VERSION >= 0x040700
+        staticText = QStaticText();
+        staticTextFont = QFont();
+#endif
     }
 
     QFont font;
     QSizeF textSize;
+
+#if QT_VERSION >= 0x040700
+    /*
+      The glyph layout of a plain text, prepared for the font of the
+      last paint operation. QStaticText keeps the glyph positions
+      for the transformation it has been prepared for and lays out
+      itself again, when being painted with a different scale.
+     */
+    QStaticText staticText;
+    QFont staticTextFont;
+#endif
 };
 
+#if QT_VERSION >= 0x040700
+
+static inline bool qwtCanDrawStaticText( const QPainter *painter,
+    const QwtTextEngine *engine, int flags, const QString &text )
+{
+    // QStaticText offers the same layout as QwtPlainTextEngine
+    // for single lines with alignment flags only
+
+    if ( engine == NULL || typeid( *engine ) != typeid( QwtPlainTextEngine ) )
+        return false;
+
+    if ( flags & ~( Qt::AlignHorizontal_Mask | Qt::AlignVertical_Mask
+        | Qt::TextDontClip | Qt::TextSingleLine ) )
+    {
+        return false;
+    }
+
+    if ( ( flags & Qt::AlignJustify ) || ( flags & Qt::AlignAbsolute ) )
+        return false;
+
+    if ( text.isEmpty() || text.contains( QLatin1Char( '\n' ) )
+        || text.contains( QLatin1Char( '\t' ) ) )
+    {
+        return false;
+    }
+
+    if ( painter->layoutDirection() != Qt::LeftToRight )
+        return false;
+
+    /*
+      On vector devices ( PDF, SVG, QwtGraphic ... ) the glyphs
+      are not cached at all. For devices with a resolution different
+      from the screen QwtPainter::drawText() adjusts the font.
+     */
+    const QPaintEngine *paintEngine = painter->paintEngine();
+    if ( paintEngine == NULL )
+        return false;
+
+    switch( paintEngine->type() )
+    {
+        case QPaintEngine::Raster:
+        case QPaintEngine::OpenGL:
+        case QPaintEngine::OpenGL2:
+            break;
+        default:
+            return false;
+    }
+
+    if ( painter->font().pixelSize() < 0 )
+    {
+        const QPaintDevice *pd = painter->device();
+        const QPaintDevice *screen = QwtPainter::screenDevice();
+
+        if ( pd->logicalDpiX() != screen->logicalDpiX() ||
+            pd->logicalDpiY() != screen->logicalDpiY() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif
+
 /*!
    Constructor
 
@@ -492,7 +592,7 @@ double QwtText::heightForWidth( double width, const QFont &defaultFont ) const
     // We want to calculate in screen metrics. So
     // we need a font that uses screen metrics
 
-    const QFont font( usedFont( defaultFont ), QApplication::desktop() );
+    const QFont font( usedFont( defaultFont ), QwtPainter::screenDevice() );
 
     double h = 0;
 
@@ -536,7 +636,7 @@ QSizeF QwtText::textSize( const QFont &defaultFont ) const
     // We want to calculate in screen metrics. So
     // we need a font that uses screen metrics
 
-    const QFont font( usedFont( defaultFont ), QApplication::desktop() );
+    const QFont font( usedFont( defaultFont ), QwtPainter::screenDevice() );
 
     if ( !d_layoutCache->textSize.isValid()
         || d_layoutCache->font != font )
@@ -562,6 +662,10 @@ QSizeF QwtText::textSize( const QFont &defaultFont ) const
 /*!
    Draw a text into a rectangle
 
+   Single line plain texts, that are painted on raster devices,
+   are drawn from a QStaticText, that is kept until the text
+   or its render flags are modified.
+
    \param painter Painter
    \param rect Rectangle
 */
@@ -611,7 +715,7 @@ void QwtText::draw( QPainter *painter, const QRectF &rect ) const
         // We want to calculate in screen metrics. So
         // we need a font that uses screen metrics
 
-        const QFont font( painter->font(), QApplication::desktop() );
+        const QFont font( painter->font(), QwtPainter::screenDevice() );
 
         double left, right, top, bottom;
         d_data->textEngine->textMargins(
@@ -623,8 +727,56 @@ void QwtText::draw( QPainter *painter, const QRectF &rect ) const
         expandedRect.setRight( rect.right() + right );
     }
 
-    d_data->textEngine->draw( painter, expandedRect,
-        d_data->renderFlags, d_data->text );
+#if QT_VERSION >= 0x040700
+    if ( qwtCanDrawStaticText( painter, d_data->textEngine,
+        d_data->renderFlags, d_data->text ) )
+    {
+        LayoutCache *cache = d_layoutCache;
+
+        const QFont font = painter->font();
+        if ( cache->staticText.text().isEmpty()
+            || font != cache->staticTextFont )
+        {
+            cache->staticText = QStaticText( d_data->text );
+            cache->staticText.setTextFormat( Qt::PlainText );
+            cache->staticText.prepare( painter->transform(), font );
+
+            cache->staticTextFont = font;
+        }
+
+        const QSizeF sz = cache->staticText.size();
+        const int flags = d_data->renderFlags;
+
+        QPointF pos = expandedRect.topLeft();
+
+        if ( flags & Qt::AlignRight )
+            pos.setX( expandedRect.right() - sz.width() );
+        else if ( flags & Qt::AlignHCenter )
+            pos.setX( expandedRect.center().x() - 0.5 * sz.width() );
+
+        if ( flags & Qt::AlignBottom )
+            pos.setY( expandedRect.bottom() - sz.height() );
+        else if ( flags & Qt::AlignVCenter )
+            pos.setY( expandedRect.center().y() - 0.5 * sz.height() );
+
+        if ( !( flags & Qt::TextDontClip ) )
+        {
+            // QPainter::drawStaticText() never clips
+            if ( sz.width() > expandedRect.width()
+                || sz.height() > expandedRect.height() )
+            {
+                painter->setClipRect( expandedRect, Qt::IntersectClip );
+            }
+        }
+
+        painter->drawStaticText( pos, cache->staticText );
+    }
+    else
+#endif
+    {
+        d_data->textEngine->draw( painter, expandedRect,
+            d_data->renderFlags, d_data->text );
+    }
 
     painter->restore();
 }
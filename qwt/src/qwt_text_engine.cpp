@@ -11,9 +11,9 @@
 #include "qwt_math.h"
 #include "qwt_painter.h"
 #include <qpainter.h>
-#include <qpixmap.h>
 #include <qimage.h>
 #include <qmap.h>
+#include <qmutex.h>
 #include <qwidget.h>
 #include <qtextobject.h>
 #include <qtextdocument.h>
@@ -84,6 +84,9 @@ public:
     {
         const QString fontKey = font.key();
 
+        // the engine is shared between all texts of all threads
+        QMutexLocker locker( &d_mutex );
+
         QMap<QString, int>::const_iterator it =
             d_ascentCache.find( fontKey );
         if ( it == d_ascentCache.end() )
@@ -102,23 +105,23 @@ private:
         static const QColor white( Qt::white );
 
         const QFontMetrics fm( font );
-        QPixmap pm( fm.width( dummy ), fm.height() );
-        pm.fill( white );
 
-        QPainter p( &pm );
+        // QPixmap can't be used outside of the GUI thread
+        QImage img( fm.width( dummy ), fm.height(), QImage::Format_ARGB32 );
+        img.fill( white.rgb() );
+
+        QPainter p( &img );
         p.setFont( font );
-        p.drawText( 0, 0,  pm.width(), pm.height(), 0, dummy );
+        p.drawText( 0, 0,  img.width(), img.height(), 0, dummy );
         p.end();
 
-        const QImage img = pm.toImage();
-
         int row = 0;
         for ( row = 0; row < img.height(); row++ )
         {
             const QRgb *line = reinterpret_cast<const QRgb *>( 
                 img.scanLine( row ) );
 
-            const int w = pm.width();
+            const int w = img.width();
             for ( int col = 0; col < w; col++ )
             {
                 if ( line[col] != white.rgb() )
@@ -129,6 +132,7 @@ private:
         return fm.ascent();
     }
 
+    mutable QMutex d_mutex;
     mutable QMap<QString, int> d_ascentCache;
 };
 
@@ -0,0 +1,934 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_virtual_legend.h"
+#include "qwt_legend_data.h"
+#include "qwt_plot_item.h"
+#include "qwt_painter.h"
+#include "qwt_graphic.h"
+#include "qwt_text.h"
+#include "qwt_math.h"
+#include <qapplication.h>
+#include <qabstractscrollarea.h>
+#include <qscrollbar.h>
+#include <qlayout.h>
+#include <qpainter.h>
+#include <qdrawutil.h>
+#include <qstyle.h>
+#include <qstyleoption.h>
+#include <qevent.h>
+#include <qhash.h>
+
+static const int ButtonFrame = 2;
+static const int Margin = 2;
+static const int Spacing = 2;
+
+static inline const QwtPlotItem *qwtPlotItem( const QVariant &itemInfo )
+{
+    if ( itemInfo.canConvert<QwtPlotItem *>() )
+        return qvariant_cast<QwtPlotItem *>( itemInfo );
+
+    return NULL;
+}
+
+static inline QwtText qwtEntryTitle( const QwtLegendData &data )
+{
+    QwtText title = data.title();
+    title.setRenderFlags( Qt::AlignLeft | Qt::AlignVCenter
+        | Qt::TextExpandTabs );
+
+    return title;
+}
+
+class QwtVirtualLegendEntry
+{
+public:
+    QVariant itemInfo;
+
+    QList<QwtLegendData> data;
+    QList<bool> checked;
+    QList<QSize> sizes;
+};
+
+class QwtVirtualLegend::PrivateData
+{
+public:
+    class Cell
+    {
+    public:
+        int entry;
+        int index;
+    };
+
+    PrivateData():
+        itemMode( QwtLegendData::ReadOnly ),
+        maxColumns( 0 ),
+        isDirty( false ),
+        pendingLayout( false ),
+        pressedCell( -1 ),
+        view( NULL )
+    {
+    }
+
+    int indexOf( const QVariant &itemInfo ) const
+    {
+        const QwtPlotItem *item = qwtPlotItem( itemInfo );
+        if ( item )
+            return itemIndex.value( item, -1 );
+
+        for ( int i = 0; i < entries.size(); i++ )
+        {
+            if ( entries[i].itemInfo == itemInfo )
+                return i;
+        }
+
+        return -1;
+    }
+
+    void updateItemIndex()
+    {
+        itemIndex.clear();
+
+        for ( int i = 0; i < entries.size(); i++ )
+        {
+            const QwtPlotItem *item = qwtPlotItem( entries[i].itemInfo );
+            if ( item )
+                itemIndex.insert( item, i );
+        }
+    }
+
+    void updateCells()
+    {
+        if ( !isDirty )
+            return;
+
+        cells.clear();
+        cellSize = QSize( 0, 0 );
+
+        for ( int i = 0; i < entries.size(); i++ )
+        {
+            const QwtVirtualLegendEntry &entry = entries[i];
+
+            for ( int j = 0; j < entry.data.size(); j++ )
+            {
+                Cell cell;
+                cell.entry = i;
+                cell.index = j;
+
+                cells += cell;
+                cellSize = cellSize.expandedTo( entry.sizes[j] );
+            }
+        }
+
+        isDirty = false;
+    }
+
+    int columnsForWidth( int width )
+    {
+        updateCells();
+
+        if ( cells.isEmpty() )
+            return 0;
+
+        int numColumns = cells.size();
+        if ( cellSize.width() > 0 )
+            numColumns = width / cellSize.width();
+
+        numColumns = qBound( 1, numColumns, cells.size() );
+        if ( maxColumns > 0 )
+            numColumns = qMin( numColumns, static_cast<int>( maxColumns ) );
+
+        return numColumns;
+    }
+
+    int rowCount( int numColumns ) const
+    {
+        if ( numColumns <= 0 )
+            return 0;
+
+        return ( cells.size() + numColumns - 1 ) / numColumns;
+    }
+
+    QwtLegendData::Mode itemMode;
+    uint maxColumns;
+
+    QList<QwtVirtualLegendEntry> entries;
+    QHash<const QwtPlotItem *, int> itemIndex;
+
+    // entries of all items in the order of the grid
+    QVector<Cell> cells;
+    QSize cellSize;
+    bool isDirty;
+
+    bool pendingLayout;
+    int pressedCell;
+
+    class View;
+    View *view;
+};
+
+class QwtVirtualLegend::PrivateData::View: public QAbstractScrollArea
+{
+public:
+    View( QwtVirtualLegend *legend ):
+        QAbstractScrollArea( legend ),
+        d_legend( legend )
+    {
+        setFrameStyle( QFrame::NoFrame );
+        setFocusPolicy( Qt::NoFocus );
+
+        viewport()->setObjectName( "QwtLegendViewport" );
+        viewport()->setAutoFillBackground( false );
+    }
+
+    void layoutGrid()
+    {
+        PrivateData *d = d_legend->d_data;
+
+        const QSize size = viewport()->size();
+
+        const int numColumns = d->columnsForWidth( size.width() );
+        const QSize contentsSize( numColumns * d->cellSize.width(),
+            d->rowCount( numColumns ) * d->cellSize.height() );
+
+        horizontalScrollBar()->setRange( 0,
+            qMax( contentsSize.width() - size.width(), 0 ) );
+        horizontalScrollBar()->setPageStep( size.width() );
+        horizontalScrollBar()->setSingleStep( d->cellSize.width() );
+
+        verticalScrollBar()->setRange( 0,
+            qMax( contentsSize.height() - size.height(), 0 ) );
+        verticalScrollBar()->setPageStep( size.height() );
+        verticalScrollBar()->setSingleStep( d->cellSize.height() );
+    }
+
+    int cellAt( const QPoint &pos ) const
+    {
+        PrivateData *d = d_legend->d_data;
+
+        const int numColumns = d->columnsForWidth( viewport()->width() );
+        if ( numColumns <= 0 || d->cellSize.isEmpty() )
+            return -1;
+
+        const QPoint p = pos - origin( numColumns );
+        if ( p.x() < 0 || p.y() < 0 )
+            return -1;
+
+        const int col = p.x() / d->cellSize.width();
+        const int row = p.y() / d->cellSize.height();
+
+        if ( col >= numColumns )
+            return -1;
+
+        const int cell = row * numColumns + col;
+        return ( cell < d->cells.size() ) ? cell : -1;
+    }
+
+    QRect cellRect( int cell ) const
+    {
+        PrivateData *d = d_legend->d_data;
+
+        const int numColumns = d->columnsForWidth( viewport()->width() );
+        if ( numColumns <= 0 )
+            return QRect();
+
+        const QPoint pos = origin( numColumns ) + QPoint(
+            ( cell % numColumns ) * d->cellSize.width(),
+            ( cell / numColumns ) * d->cellSize.height() );
+
+        return QRect( pos, d->cellSize );
+    }
+
+protected:
+    virtual void resizeEvent( QResizeEvent *event )
+    {
+        QAbstractScrollArea::resizeEvent( event );
+        layoutGrid();
+    }
+
+    virtual void scrollContentsBy( int, int )
+    {
+        viewport()->update();
+    }
+
+    virtual void paintEvent( QPaintEvent *event )
+    {
+        PrivateData *d = d_legend->d_data;
+
+        const int numColumns = d->columnsForWidth( viewport()->width() );
+        if ( numColumns <= 0 || d->cellSize.isEmpty() )
+            return;
+
+        QPainter painter( viewport() );
+        painter.setClipRegion( event->region() );
+
+        // painting the visible rows only
+
+        const QRect rect = event->rect();
+        const QPoint pos = origin( numColumns );
+
+        const int h = d->cellSize.height();
+
+        const int firstRow = qMax( ( rect.top() - pos.y() ) / h, 0 );
+        const int lastRow = qMin( ( rect.bottom() - pos.y() ) / h,
+            d->rowCount( numColumns ) - 1 );
+
+        for ( int row = firstRow; row <= lastRow; row++ )
+        {
+            for ( int col = 0; col < numColumns; col++ )
+            {
+                const int cell = row * numColumns + col;
+                if ( cell >= d->cells.size() )
+                    break;
+
+                const PrivateData::Cell &c = d->cells[cell];
+                const QwtVirtualLegendEntry &entry = d->entries[c.entry];
+
+                const bool isDown = ( cell == d->pressedCell )
+                    || entry.checked[c.index];
+
+                painter.save();
+                d_legend->drawEntry( &painter, entry.data[c.index],
+                    cellRect( cell ), isDown );
+                painter.restore();
+            }
+        }
+    }
+
+    virtual void mousePressEvent( QMouseEvent *event )
+    {
+        PrivateData *d = d_legend->d_data;
+
+        if ( event->button() != Qt::LeftButton )
+            return;
+
+        const int cell = cellAt( event->pos() );
+        if ( cell >= 0 )
+        {
+            const PrivateData::Cell &c = d->cells[cell];
+            const QwtLegendData &data = d->entries[c.entry].data[c.index];
+
+            if ( d_legend->entryMode( data ) != QwtLegendData::ReadOnly )
+            {
+                d->pressedCell = cell;
+                viewport()->update( cellRect( cell ) );
+            }
+        }
+    }
+
+    virtual void mouseReleaseEvent( QMouseEvent *event )
+    {
+        PrivateData *d = d_legend->d_data;
+
+        if ( event->button() != Qt::LeftButton || d->pressedCell < 0 )
+            return;
+
+        const int pressedCell = d->pressedCell;
+
+        d->pressedCell = -1;
+        viewport()->update( cellRect( pressedCell ) );
+
+        if ( cellAt( event->pos() ) != pressedCell )
+            return;
+
+        const PrivateData::Cell c = d->cells[pressedCell];
+        QwtVirtualLegendEntry &entry = d->entries[c.entry];
+
+        // the slots connected to the signals might update the legend,
+        // so we better work on copies
+
+        const QVariant itemInfo = entry.itemInfo;
+
+        switch( d_legend->entryMode( entry.data[c.index] ) )
+        {
+            case QwtLegendData::Clickable:
+            {
+                Q_EMIT d_legend->clicked( itemInfo, c.index );
+                break;
+            }
+            case QwtLegendData::Checkable:
+            {
+                const bool on = !entry.checked[c.index];
+                entry.checked[c.index] = on;
+
+                Q_EMIT d_legend->checked( itemInfo, on, c.index );
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+private:
+    QPoint origin( int numColumns ) const
+    {
+        // aligned like QwtLegend: Qt::AlignHCenter | Qt::AlignTop
+
+        const QwtVirtualLegend::PrivateData *d = d_legend->d_data;
+
+        const int w = numColumns * d->cellSize.width();
+        const int x = qMax( ( viewport()->width() - w ) / 2, 0 );
+
+        return QPoint( x - horizontalScrollBar()->value(),
+            -verticalScrollBar()->value() );
+    }
+
+    QwtVirtualLegend *d_legend;
+};
+
+/*!
+  Constructor
+  \param parent Parent widget
+*/
+QwtVirtualLegend::QwtVirtualLegend( QWidget *parent ):
+    QwtAbstractLegend( parent )
+{
+    setFrameStyle( NoFrame );
+
+    d_data = new QwtVirtualLegend::PrivateData;
+
+    d_data->view = new QwtVirtualLegend::PrivateData::View( this );
+    d_data->view->setObjectName( "QwtLegendView" );
+
+    QVBoxLayout *layout = new QVBoxLayout( this );
+    layout->setContentsMargins( 0, 0, 0, 0 );
+    layout->addWidget( d_data->view );
+}
+
+//! Destructor
+QwtVirtualLegend::~QwtVirtualLegend()
+{
+    delete d_data;
+}
+
+/*!
+  \brief Set the maximum number of entries in a row
+
+  F.e when the maximum is set to 1 all entries are aligned
+  vertically. 0 means unlimited
+
+  \param numColums Maximum number of entries in a row
+  \sa maxColumns()
+ */
+void QwtVirtualLegend::setMaxColumns( uint numColums )
+{
+    if ( numColums != d_data->maxColumns )
+    {
+        d_data->maxColumns = numColums;
+
+        d_data->view->layoutGrid();
+        d_data->view->viewport()->update();
+
+        updateGeometry();
+    }
+}
+
+/*!
+  \return Maximum number of entries in a row
+  \sa setMaxColumns()
+ */
+uint QwtVirtualLegend::maxColumns() const
+{
+    return d_data->maxColumns;
+}
+
+/*!
+  \brief Set the default mode for legend entries
+
+  When a QwtLegendData object doesn't contain a value for
+  the QwtLegendData::ModeRole the entry is operated in the
+  default mode of the legend.
+
+  \param mode Default item mode
+  \sa defaultItemMode()
+ */
+void QwtVirtualLegend::setDefaultItemMode( QwtLegendData::Mode mode )
+{
+    if ( mode != d_data->itemMode )
+    {
+        d_data->itemMode = mode;
+
+        for ( int i = 0; i < d_data->entries.size(); i++ )
+        {
+            QwtVirtualLegendEntry &entry = d_data->entries[i];
+            for ( int j = 0; j < entry.data.size(); j++ )
+                entry.sizes[j] = entrySize( entry.data[j] );
+        }
+
+        d_data->isDirty = true;
+
+        d_data->view->layoutGrid();
+        d_data->view->viewport()->update();
+
+        updateGeometry();
+    }
+}
+
+/*!
+  \return Default item mode
+  \sa setDefaultItemMode()
+*/
+QwtLegendData::Mode QwtVirtualLegend::defaultItemMode() const
+{
+    return d_data->itemMode;
+}
+
+/*!
+  Check/Uncheck a legend entry in QwtLegendData::Checkable mode
+
+  \param itemInfo Info about an item
+  \param on Check/Uncheck
+  \param index Index of the entry in the list of entries of the item
+
+  \sa isChecked(), checked()
+  \note No checked() signal is emitted
+ */
+void QwtVirtualLegend::setChecked(
+    const QVariant &itemInfo, bool on, int index )
+{
+    const int entryIndex = d_data->indexOf( itemInfo );
+    if ( entryIndex < 0 )
+        return;
+
+    QwtVirtualLegendEntry &entry = d_data->entries[entryIndex];
+    if ( index >= 0 && index < entry.checked.size()
+        && entry.checked[index] != on )
+    {
+        entry.checked[index] = on;
+        d_data->view->viewport()->update();
+    }
+}
+
+/*!
+  \return True, when the legend entry is checked
+  \param itemInfo Info about an item
+  \param index Index of the entry in the list of entries of the item
+
+  \sa setChecked()
+ */
+bool QwtVirtualLegend::isChecked( const QVariant &itemInfo, int index ) const
+{
+    const int entryIndex = d_data->indexOf( itemInfo );
+    if ( entryIndex < 0 )
+        return false;
+
+    const QwtVirtualLegendEntry &entry = d_data->entries[entryIndex];
+    if ( index < 0 || index >= entry.checked.size() )
+        return false;
+
+    return entry.checked[index];
+}
+
+//! \return Number of legend entries of all items
+int QwtVirtualLegend::entryCount() const
+{
+    d_data->updateCells();
+    return d_data->cells.size();
+}
+
+/*!
+  Find the legend entry at a position
+
+  \param pos Position in widget coordinates
+  \param itemInfo Info about the item of the entry
+  \return Index of the entry in the list of entries of the item,
+          or -1, when there is no entry at pos
+ */
+int QwtVirtualLegend::entryAt( const QPoint &pos, QVariant &itemInfo ) const
+{
+    const QWidget *viewport = d_data->view->viewport();
+
+    const int cell = d_data->view->cellAt( viewport->mapFrom( this, pos ) );
+    if ( cell < 0 )
+        return -1;
+
+    const PrivateData::Cell &c = d_data->cells[cell];
+    itemInfo = d_data->entries[c.entry].itemInfo;
+
+    return c.index;
+}
+
+//! \return Size hint
+QSize QwtVirtualLegend::sizeHint() const
+{
+    d_data->updateCells();
+
+    int numColumns = d_data->cells.size();
+    if ( d_data->maxColumns > 0 )
+        numColumns = qMin( numColumns, static_cast<int>( d_data->maxColumns ) );
+
+    QSize hint( numColumns * d_data->cellSize.width(),
+        d_data->rowCount( numColumns ) * d_data->cellSize.height() );
+    hint += QSize( 2 * frameWidth(), 2 * frameWidth() );
+
+    return hint;
+}
+
+/*!
+  \return The preferred height, for a width.
+  \param width Width
+*/
+int QwtVirtualLegend::heightForWidth( int width ) const
+{
+    width -= 2 * frameWidth();
+
+    const int numColumns = d_data->columnsForWidth( width );
+
+    return d_data->rowCount( numColumns ) * d_data->cellSize.height()
+        + 2 * frameWidth();
+}
+
+/*!
+  \return Horizontal scrollbar
+  \sa verticalScrollBar()
+*/
+QScrollBar *QwtVirtualLegend::horizontalScrollBar() const
+{
+    return d_data->view->horizontalScrollBar();
+}
+
+/*!
+  \return Vertical scrollbar
+  \sa horizontalScrollBar()
+*/
+QScrollBar *QwtVirtualLegend::verticalScrollBar() const
+{
+    return d_data->view->verticalScrollBar();
+}
+
+/*!
+  \brief Update the entries for an item
+
+  Only the attributes of the entries are stored, the layout
+  of the grid is updated delayed, when control returns to the
+  event loop.
+
+  \param itemInfo Info for an item
+  \param data List of legend entry attributes for the item
+ */
+void QwtVirtualLegend::updateLegend( const QVariant &itemInfo,
+    const QList<QwtLegendData> &data )
+{
+    int index = d_data->indexOf( itemInfo );
+
+    if ( data.isEmpty() )
+    {
+        if ( index < 0 )
+            return;
+
+        d_data->entries.removeAt( index );
+        d_data->updateItemIndex();
+    }
+    else
+    {
+        if ( index < 0 )
+        {
+            QwtVirtualLegendEntry entry;
+            entry.itemInfo = itemInfo;
+
+            d_data->entries += entry;
+            index = d_data->entries.size() - 1;
+
+            const QwtPlotItem *item = qwtPlotItem( itemInfo );
+            if ( item )
+                d_data->itemIndex.insert( item, index );
+        }
+
+        QwtVirtualLegendEntry &entry = d_data->entries[index];
+
+        entry.data = data;
+
+        while ( entry.checked.size() > data.size() )
+            entry.checked.removeLast();
+
+        while ( entry.checked.size() < data.size() )
+            entry.checked += false;
+
+        entry.sizes.clear();
+        for ( int i = 0; i < data.size(); i++ )
+            entry.sizes += entrySize( data[i] );
+    }
+
+    d_data->isDirty = true;
+    d_data->pressedCell = -1;
+
+    if ( !d_data->pendingLayout )
+    {
+        // many items are usually updated in a row, so we
+        // collect them and layout the grid only once
+
+        d_data->pendingLayout = true;
+        QApplication::postEvent( this, new QEvent( QEvent::LayoutRequest ) );
+    }
+
+    d_data->view->viewport()->update();
+}
+
+/*!
+  Handle QEvent::LayoutRequest events, that have been posted
+  by updateLegend()
+
+  \param event Event
+  \return See QwtAbstractLegend::event()
+*/
+bool QwtVirtualLegend::event( QEvent *event )
+{
+    if ( event->type() == QEvent::LayoutRequest && d_data->pendingLayout )
+    {
+        d_data->pendingLayout = false;
+
+        d_data->view->layoutGrid();
+        d_data->view->viewport()->update();
+
+        updateGeometry();
+
+        if ( parentWidget() && parentWidget()->layout() == NULL )
+        {
+            // like QwtLegend: the parent widget ( usually QwtPlot )
+            // needs to recalculate its layout, even when the legend
+            // is hidden
+
+            QApplication::postEvent( parentWidget(),
+                new QEvent( QEvent::LayoutRequest ) );
+        }
+    }
+
+    return QwtAbstractLegend::event( event );
+}
+
+/*!
+  Recalculate the size of the entries, when the font or style
+  has changed
+
+  \param event Event
+*/
+void QwtVirtualLegend::changeEvent( QEvent *event )
+{
+    QwtAbstractLegend::changeEvent( event );
+
+    if ( event->type() == QEvent::FontChange
+        || event->type() == QEvent::StyleChange )
+    {
+        for ( int i = 0; i < d_data->entries.size(); i++ )
+        {
+            QwtVirtualLegendEntry &entry = d_data->entries[i];
+            for ( int j = 0; j < entry.data.size(); j++ )
+                entry.sizes[j] = entrySize( entry.data[j] );
+        }
+
+        d_data->isDirty = true;
+
+        d_data->view->layoutGrid();
+        d_data->view->viewport()->update();
+
+        updateGeometry();
+    }
+}
+
+/*!
+  Render the legend into a given rectangle.
+
+  \param painter Painter
+  \param rect Bounding rectangle
+  \param fillBackground When true, fill rect with the widget background
+
+  \sa renderLegend() is used by QwtPlotRenderer - not by QwtVirtualLegend itself
+*/
+void QwtVirtualLegend::renderLegend( QPainter *painter,
+    const QRectF &rect, bool fillBackground ) const
+{
+    if ( d_data->entries.isEmpty() )
+        return;
+
+    if ( fillBackground )
+    {
+        if ( autoFillBackground() ||
+            testAttribute( Qt::WA_StyledBackground ) )
+        {
+            QwtPainter::drawBackgound( painter, rect, this );
+        }
+    }
+
+    int left, right, top, bottom;
+    getContentsMargins( &left, &top, &right, &bottom );
+
+    QRect layoutRect;
+    layoutRect.setLeft( qCeil( rect.left() ) + left );
+    layoutRect.setTop( qCeil( rect.top() ) + top );
+    layoutRect.setRight( qFloor( rect.right() ) - right );
+    layoutRect.setBottom( qFloor( rect.bottom() ) - bottom );
+
+    const int numColumns = d_data->columnsForWidth( layoutRect.width() );
+    if ( numColumns <= 0 )
+        return;
+
+    const QSize &cellSize = d_data->cellSize;
+
+    const int x0 = layoutRect.left()
+        + qMax( ( layoutRect.width() - numColumns * cellSize.width() ) / 2, 0 );
+
+    for ( int i = 0; i < d_data->cells.size(); i++ )
+    {
+        const QRect cellRect(
+            x0 + ( i % numColumns ) * cellSize.width(),
+            layoutRect.top() + ( i / numColumns ) * cellSize.height(),
+            cellSize.width(), cellSize.height() );
+
+        if ( cellRect.top() > layoutRect.bottom() )
+            break;
+
+        const PrivateData::Cell &c = d_data->cells[i];
+        const QwtVirtualLegendEntry &entry = d_data->entries[c.entry];
+
+        painter->save();
+
+        painter->setClipRect( cellRect, Qt::IntersectClip );
+        drawEntry( painter, entry.data[c.index], cellRect,
+            entry.checked[c.index] );
+
+        painter->restore();
+    }
+}
+
+//! \return True, when no item is inserted
+bool QwtVirtualLegend::isEmpty() const
+{
+    return d_data->entries.isEmpty();
+}
+
+/*!
+    Return the extent, that is needed for the scrollbars
+
+    \param orientation Orientation
+    \return The width of the vertical scrollbar for Qt::Horizontal and v.v.
+ */
+int QwtVirtualLegend::scrollExtent( Qt::Orientation orientation ) const
+{
+    int extent = 0;
+
+    if ( orientation == Qt::Horizontal )
+        extent = verticalScrollBar()->sizeHint().width();
+    else
+        extent = horizontalScrollBar()->sizeHint().height();
+
+    return extent;
+}
+
+/*!
+  Calculate the size, that is needed to display a legend entry
+
+  The size of the cells of the grid is the maximum of all entry sizes.
+
+  \param data Attributes of the legend entry
+  \return Size of the entry
+
+  \sa drawEntry()
+ */
+QSize QwtVirtualLegend::entrySize( const QwtLegendData &data ) const
+{
+    int w = 0;
+    int h = 0;
+
+    const QwtGraphic icon = data.icon();
+    if ( !icon.isNull() )
+    {
+        const QSizeF sz = icon.defaultSize();
+
+        w = qCeil( sz.width() );
+        h = qCeil( sz.height() ) + 4;
+    }
+
+    const QwtText title = qwtEntryTitle( data );
+    if ( !title.isEmpty() )
+    {
+        const QSizeF sz = title.textSize( font() );
+
+        if ( w > 0 )
+            w += Spacing;
+
+        w += qCeil( sz.width() );
+        h = qMax( h, qCeil( sz.height() ) );
+    }
+
+    int m = Margin;
+    if ( entryMode( data ) != QwtLegendData::ReadOnly )
+        m += ButtonFrame;
+
+    return QSize( w + 2 * m, h + 2 * m );
+}
+
+/*!
+  Draw a legend entry like QwtLegendLabel
+
+  \param painter Painter
+  \param data Attributes of the legend entry
+  \param rect Bounding rectangle of the entry
+  \param isDown True, when the entry is pressed or checked
+
+  \sa entrySize()
+ */
+void QwtVirtualLegend::drawEntry( QPainter *painter,
+    const QwtLegendData &data, const QRect &rect, bool isDown ) const
+{
+    QRect r = rect.adjusted( Margin, Margin, -Margin, -Margin );
+
+    if ( entryMode( data ) != QwtLegendData::ReadOnly )
+    {
+        r.adjust( ButtonFrame, ButtonFrame, -ButtonFrame, -ButtonFrame );
+
+        if ( isDown )
+        {
+            qDrawWinButton( painter, rect.x(), rect.y(),
+                rect.width(), rect.height(), palette(), true );
+
+            QStyleOption option;
+            option.init( this );
+
+            r.translate(
+                style()->pixelMetric( QStyle::PM_ButtonShiftHorizontal, &option, this ),
+                style()->pixelMetric( QStyle::PM_ButtonShiftVertical, &option, this ) );
+        }
+    }
+
+    painter->setClipRect( r, Qt::IntersectClip );
+
+    int titleOffset = 0;
+
+    const QwtGraphic icon = data.icon();
+    if ( !icon.isNull() )
+    {
+        QRectF iconRect( r.topLeft(), icon.defaultSize() );
+        iconRect.moveCenter( QPointF( iconRect.center().x(), r.center().y() ) );
+
+        icon.render( painter, iconRect, Qt::KeepAspectRatio );
+
+        titleOffset += qCeil( iconRect.width() ) + Spacing;
+    }
+
+    const QwtText title = qwtEntryTitle( data );
+    if ( !title.isEmpty() )
+    {
+        painter->setPen( palette().color( QPalette::Text ) );
+        painter->setFont( font() );
+
+        title.draw( painter, r.adjusted( titleOffset, 0, 0, 0 ) );
+    }
+}
+
+QwtLegendData::Mode QwtVirtualLegend::entryMode(
+    const QwtLegendData &data ) const
+{
+    // use the default mode, when there is no specific
+    // hint from the legend data
+
+    if ( data.value( QwtLegendData::ModeRole ).isValid() )
+        return data.mode();
+
+    return d_data->itemMode;
+}
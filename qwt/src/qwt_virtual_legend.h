@@ -0,0 +1,112 @@
+/* -*- mode: C++ ; c-file-style: "stroustrup" -*- *****************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_VIRTUAL_LEGEND_H
+#define QWT_VIRTUAL_LEGEND_H
+
+#include "qwt_global.h"
+#include "qwt_abstract_legend.h"
+#include <qvariant.h>
+
+class QScrollBar;
+
+/*!
+  \brief A legend, that displays its entries without creating widgets
+
+  QwtLegend creates a widget for each entry, what doesn't scale
+  for plots with thousands of items. QwtVirtualLegend stores the
+  QwtLegendData of the entries only and paints the visible
+  entries in the paint event of a scroll area - like the item views of Qt.
+
+  All entries are arranged in a grid of cells of the same size,
+  from the left to the right and from the top to the bottom.
+  Entries in QwtLegendData::Clickable or QwtLegendData::Checkable mode
+  can be operated with the mouse.
+
+  \sa QwtLegend, QwtPlot::insertLegend()
+*/
+class QWT_EXPORT QwtVirtualLegend : public QwtAbstractLegend
+{
+    Q_OBJECT
+
+public:
+    explicit QwtVirtualLegend( QWidget *parent = NULL );
+    virtual ~QwtVirtualLegend();
+
+    void setMaxColumns( uint numColums );
+    uint maxColumns() const;
+
+    void setDefaultItemMode( QwtLegendData::Mode );
+    QwtLegendData::Mode defaultItemMode() const;
+
+    void setChecked( const QVariant &itemInfo, bool on, int index = 0 );
+    bool isChecked( const QVariant &itemInfo, int index = 0 ) const;
+
+    int entryCount() const;
+    int entryAt( const QPoint &, QVariant &itemInfo ) const;
+
+    virtual QSize sizeHint() const;
+    virtual int heightForWidth( int w ) const;
+
+    QScrollBar *horizontalScrollBar() const;
+    QScrollBar *verticalScrollBar() const;
+
+    virtual void renderLegend( QPainter *,
+        const QRectF &, bool fillBackground ) const;
+
+    virtual bool isEmpty() const;
+    virtual int scrollExtent( Qt::Orientation ) const;
+
+Q_SIGNALS:
+    /*!
+      A signal which is emitted when the user has clicked on
+      a legend entry, which is in QwtLegendData::Clickable mode.
+
+      \param itemInfo Info for the item of the selected legend entry
+      \param index Index of the legend entry in the list of entries
+                   that are associated with the plot item
+
+      \sa setDefaultItemMode(), QwtPlot::itemToInfo()
+     */
+    void clicked( const QVariant &itemInfo, int index );
+
+    /*!
+      A signal which is emitted when the user has clicked on
+      a legend entry, which is in QwtLegendData::Checkable mode
+
+      \param itemInfo Info for the item of the selected legend entry
+      \param on True when the legend entry is checked
+      \param index Index of the legend entry in the list of entries
+                   that are associated with the plot item
+
+      \sa setDefaultItemMode(), QwtPlot::itemToInfo()
+     */
+    void checked( const QVariant &itemInfo, bool on, int index );
+
+public Q_SLOTS:
+    virtual void updateLegend( const QVariant &,
+        const QList<QwtLegendData> & );
+
+protected:
+    virtual bool event( QEvent * );
+    virtual void changeEvent( QEvent * );
+
+    virtual QSize entrySize( const QwtLegendData & ) const;
+
+    virtual void drawEntry( QPainter *, const QwtLegendData &,
+        const QRect &, bool isDown ) const;
+
+private:
+    QwtLegendData::Mode entryMode( const QwtLegendData & ) const;
+
+    class PrivateData;
+    PrivateData *d_data;
+};
+
+#endif
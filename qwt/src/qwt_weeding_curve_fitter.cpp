@@ -11,6 +11,9 @@
 #include "qwt_math.h"
 #include <qstack.h>
 #include <qvector.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
 
 #if QT_VERSION < 0x040601
 #define qFabs(x) ::fabs(x)
@@ -20,13 +23,17 @@ class QwtWeedingCurveFitter::PrivateData
 {
 public:
     PrivateData():
+        algorithm( QwtWeedingCurveFitter::DouglasPeucker ),
         tolerance( 1.0 ),
-        chunkSize( 0 )
+        chunkSize( 0 ),
+        threadCount( 1 )
     {
     }
 
+    QwtWeedingCurveFitter::Algorithm algorithm;
     double tolerance;
     uint chunkSize;
+    uint threadCount;
 };
 
 class QwtWeedingCurveFitter::Line
@@ -42,6 +49,131 @@ public:
     int to;
 };
 
+static inline double qwtTriangleArea( 
+    const QPointF &p1, const QPointF &p2, const QPointF &p3 )
+{
+    const double area = ( p2.x() - p1.x() ) * ( p3.y() - p1.y() )
+        - ( p3.x() - p1.x() ) * ( p2.y() - p1.y() );
+
+    return 0.5 * qAbs( area );
+}
+
+/*
+   A binary min heap of point indexes sorted by the area, 
+   that allows to modify the area of an index in O( log( n ) )
+ */
+class QwtWeedingHeap
+{
+public:
+    QwtWeedingHeap( int numPoints ):
+        d_size( 0 ),
+        d_indexes( numPoints ),
+        d_positions( numPoints, -1 ),
+        d_areas( numPoints, 0.0 )
+    {
+    }
+
+    inline bool isEmpty() const
+    {
+        return d_size == 0;
+    }
+
+    inline int top() const
+    {
+        return d_indexes[0];
+    }
+
+    inline double area( int index ) const
+    {
+        return d_areas[index];
+    }
+
+    inline void insert( int index, double area )
+    {
+        d_areas[index] = area;
+
+        move( index, d_size );
+        siftUp( d_size++ );
+    }
+
+    inline void pop()
+    {
+        d_positions[ d_indexes[0] ] = -1;
+
+        if ( --d_size > 0 )
+        {
+            move( d_indexes[d_size], 0 );
+            siftDown( 0 );
+        }
+    }
+
+    inline void update( int index, double area )
+    {
+        const double oldArea = d_areas[index];
+        d_areas[index] = area;
+
+        if ( area < oldArea )
+            siftUp( d_positions[index] );
+        else
+            siftDown( d_positions[index] );
+    }
+
+private:
+    inline void move( int index, int pos )
+    {
+        d_indexes[pos] = index;
+        d_positions[index] = pos;
+    }
+
+    inline void siftUp( int pos )
+    {
+        const int index = d_indexes[pos];
+
+        while ( pos > 0 )
+        {
+            const int parent = ( pos - 1 ) / 2;
+            if ( d_areas[ d_indexes[parent] ] <= d_areas[index] )
+                break;
+
+            move( d_indexes[parent], pos );
+            pos = parent;
+        }
+
+        move( index, pos );
+    }
+
+    inline void siftDown( int pos )
+    {
+        const int index = d_indexes[pos];
+
+        while ( true )
+        {
+            int child = 2 * pos + 1;
+            if ( child >= d_size )
+                break;
+
+            if ( child + 1 < d_size && 
+                d_areas[ d_indexes[child + 1] ] < d_areas[ d_indexes[child] ] )
+            {
+                child++;
+            }
+
+            if ( d_areas[ d_indexes[child] ] >= d_areas[index] )
+                break;
+
+            move( d_indexes[child], pos );
+            pos = child;
+        }
+
+        move( index, pos );
+    }
+
+    int d_size;
+    QVector<int> d_indexes;
+    QVector<int> d_positions;
+    QVector<double> d_areas;
+};
+
 /*!
    Constructor
 
@@ -61,6 +193,30 @@ QwtWeedingCurveFitter::~QwtWeedingCurveFitter()
     delete d_data;
 }
 
+/*!
+  Set the algorithm, that is used for simplifying the curve
+
+  \param algorithm Algorithm
+  \sa algorithm()
+ */
+void QwtWeedingCurveFitter::setAlgorithm( Algorithm algorithm )
+{
+    if ( algorithm != d_data->algorithm )
+    {
+        d_data->algorithm = algorithm;
+        invalidate();
+    }
+}
+
+/*!
+  \return Algorithm, that is used for simplifying the curve
+  \sa setAlgorithm()
+ */
+QwtWeedingCurveFitter::Algorithm QwtWeedingCurveFitter::algorithm() const
+{
+    return d_data->algorithm;
+}
+
 /*!
  Assign the tolerance
 
@@ -76,7 +232,12 @@ QwtWeedingCurveFitter::~QwtWeedingCurveFitter()
 */
 void QwtWeedingCurveFitter::setTolerance( double tolerance )
 {
-    d_data->tolerance = qMax( tolerance, 0.0 );
+    tolerance = qMax( tolerance, 0.0 );
+    if ( tolerance != d_data->tolerance )
+    {
+        d_data->tolerance = tolerance;
+        invalidate();
+    }
 }
 
 /*!
@@ -104,7 +265,11 @@ void QwtWeedingCurveFitter::setChunkSize( uint numPoints )
     if ( numPoints > 0 )
         numPoints = qMax( numPoints, 3U );
 
-    d_data->chunkSize = numPoints;
+    if ( numPoints != d_data->chunkSize )
+    {
+        d_data->chunkSize = numPoints;
+        invalidate();
+    }
 }
 
 /*!
@@ -118,6 +283,34 @@ uint QwtWeedingCurveFitter::chunkSize() const
     return d_data->chunkSize;
 }
 
+/*!
+   Set the number of threads, that are used for processing the chunks
+
+   The chunks are distributed to the threads, so that each thread
+   processes a consecutive range of chunks. Without a chunk size
+   ( see setChunkSize() ) the polygon is processed in one thread.
+
+   \param numThreads Number of threads to be used
+                     If numThreads is set to 0, the system specific
+                     ideal thread count is used.
+
+   The default thread count is 1 ( = no additional threads )
+   \sa threadCount(), setChunkSize()
+ */
+void QwtWeedingCurveFitter::setThreadCount( uint numThreads )
+{
+    d_data->threadCount = numThreads;
+}
+
+/*!
+   \return Number of threads to be used for processing the chunks
+   \sa setThreadCount()
+ */
+uint QwtWeedingCurveFitter::threadCount() const
+{
+    return d_data->threadCount;
+}
+
 /*!
   \param points Series of data points
   \return Curve points
@@ -125,22 +318,52 @@ uint QwtWeedingCurveFitter::chunkSize() const
 */
 QPolygonF QwtWeedingCurveFitter::fitCurve( const QPolygonF &points ) const
 {
-    QPolygonF fittedPoints;
+    const int numPoints = points.size();
+    if ( numPoints == 0 )
+        return QPolygonF();
 
-    if ( d_data->chunkSize == 0 )
-    {
-        fittedPoints = simplify( points );
-    }
-    else
+    int chunkSize = d_data->chunkSize;
+    if ( chunkSize <= 0 || chunkSize > numPoints )
+        chunkSize = numPoints;
+
+    const int numChunks = ( numPoints + chunkSize - 1 ) / chunkSize;
+
+#if !defined(QT_NO_QFUTURE)
+    int numThreads = d_data->threadCount;
+    if ( numThreads <= 0 )
+        numThreads = QThread::idealThreadCount();
+
+    numThreads = qMin( numThreads, numChunks );
+
+    if ( numThreads > 1 )
     {
-        for ( int i = 0; i < points.size(); i += d_data->chunkSize )
+        // the chunks are processed in place - without copying them
+
+        QList< QFuture<QPolygonF> > futures;
+        for ( int i = 0; i < numThreads - 1; i++ )
         {
-            const QPolygonF p = points.mid( i, d_data->chunkSize );
-            fittedPoints += simplify( p );
+            futures += QtConcurrent::run( 
+                this, &QwtWeedingCurveFitter::simplifyChunks,
+                points.constData(), numPoints, 
+                i * numChunks / numThreads, 
+                ( i + 1 ) * numChunks / numThreads );
         }
+
+        const QPolygonF lastPoints = simplifyChunks( 
+            points.constData(), numPoints,
+            ( numThreads - 1 ) * numChunks / numThreads, numChunks );
+
+        QPolygonF fittedPoints;
+        for ( int i = 0; i < futures.size(); i++ )
+            fittedPoints += futures[i].result();
+
+        fittedPoints += lastPoints;
+
+        return fittedPoints;
     }
+#endif
 
-    return fittedPoints;
+    return simplifyChunks( points.constData(), numPoints, 0, numChunks );
 }
 
 /*!
@@ -155,16 +378,65 @@ QPainterPath QwtWeedingCurveFitter::fitCurvePath( const QPolygonF &points ) cons
     return path;
 }
 
+QPolygonF QwtWeedingCurveFitter::simplifyChunks( const QPointF *points,
+    int numPoints, int fromChunk, int toChunk ) const
+{
+    int chunkSize = d_data->chunkSize;
+    if ( chunkSize <= 0 || chunkSize > numPoints )
+        chunkSize = numPoints;
+
+    QPolygonF fittedPoints;
+
+    for ( int i = fromChunk; i < toChunk; i++ )
+    {
+        const int from = i * chunkSize;
+        const int n = qMin( chunkSize, numPoints - from );
+
+        fittedPoints += simplify( points + from, n );
+    }
+
+    return fittedPoints;
+}
+
+/*!
+  \brief Simplify a polygon
+
+  Obsolete: the chunks are passed to simplify( const QPointF *, int )
+  without copying them into a polygon. Reimplementations of this
+  method are not called anymore and need to be ported.
+
+  \param points Points
+  \return Simplified polygon
+ */
 QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF &points ) const
+{
+    return simplify( points.constData(), points.size() );
+}
+
+/*!
+  \brief Simplify a chunk of points
+
+  \param points Points of the chunk
+  \param numPoints Number of points
+  \return Simplified chunk
+ */
+QPolygonF QwtWeedingCurveFitter::simplify(
+    const QPointF *points, int numPoints ) const
+{
+    if ( d_data->algorithm == VisvalingamWhyatt )
+        return simplifyVisvalingamWhyatt( points, numPoints );
+
+    return simplifyDouglasPeucker( points, numPoints );
+}
+
+QPolygonF QwtWeedingCurveFitter::simplifyDouglasPeucker( 
+    const QPointF *p, int nPoints ) const
 {
     const double toleranceSqr = d_data->tolerance * d_data->tolerance;
 
     QStack<Line> stack;
     stack.reserve( 500 );
 
-    const QPointF *p = points.data();
-    const int nPoints = points.size();
-
     QVector<bool> usePoint( nPoints, false );
 
     stack.push( Line( 0, nPoints - 1 ) );
@@ -239,3 +511,81 @@ QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF &points ) const
 
     return stripped;
 }
+
+QPolygonF QwtWeedingCurveFitter::simplifyVisvalingamWhyatt(
+    const QPointF *p, int nPoints ) const
+{
+    if ( nPoints < 3 )
+    {
+        QPolygonF points( nPoints );
+        for ( int i = 0; i < nPoints; i++ )
+            points[i] = p[i];
+
+        return points;
+    }
+
+    const double minArea = 0.5 * d_data->tolerance * d_data->tolerance;
+
+    // a double linked list of the remaining points
+
+    QVector<int> prev( nPoints );
+    QVector<int> next( nPoints );
+
+    for ( int i = 0; i < nPoints; i++ )
+    {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+
+    QwtWeedingHeap heap( nPoints );
+    for ( int i = 1; i < nPoints - 1; i++ )
+        heap.insert( i, qwtTriangleArea( p[i - 1], p[i], p[i + 1] ) );
+
+    QVector<bool> usePoint( nPoints, true );
+    int numRemaining = nPoints;
+
+    while ( !heap.isEmpty() )
+    {
+        const int i = heap.top();
+
+        const double area = heap.area( i );
+        if ( area >= minArea )
+            break;
+
+        heap.pop();
+        usePoint[i] = false;
+        numRemaining--;
+
+        const int i1 = prev[i];
+        const int i2 = next[i];
+
+        next[i1] = i2;
+        prev[i2] = i1;
+
+        // the area of a point never gets below the area 
+        // of a point, that has been removed before
+
+        if ( i1 > 0 )
+        {
+            const double a = qwtTriangleArea( p[ prev[i1] ], p[i1], p[i2] );
+            heap.update( i1, qMax( a, area ) );
+        }
+
+        if ( i2 < nPoints - 1 )
+        {
+            const double a = qwtTriangleArea( p[i1], p[i2], p[ next[i2] ] );
+            heap.update( i2, qMax( a, area ) );
+        }
+    }
+
+    QPolygonF stripped( numRemaining );
+
+    int pos = 0;
+    for ( int i = 0; i < nPoints; i++ )
+    {
+        if ( usePoint[i] )
+            stripped[pos++] = p[i];
+    }
+
+    return stripped;
+}
@@ -25,7 +25,11 @@
   and might be very slow for huge polygons. To avoid performance issues
   it might be useful to split the polygon ( setChunkSize() ) and to run the algorithm
   for these smaller parts. The disadvantage of having no interpolation
-  at the borders is for most use cases irrelevant.
+  at the borders is for most use cases irrelevant. The chunks can be
+  processed in parallel threads ( setThreadCount() ).
+
+  As alternative the Visvalingam-Whyatt algorithm can be used,
+  that has a guaranteed runtime of O( n * log( n ) ) ( setAlgorithm() ).
 
   The smoothed curve consists of a subset of the points that defined the
   original curve.
@@ -38,20 +42,57 @@
 class QWT_EXPORT QwtWeedingCurveFitter: public QwtCurveFitter
 {
 public:
+    /*!
+      \brief Simplification algorithm
+      \sa setAlgorithm()
+     */
+    enum Algorithm
+    {
+        /*!
+          Douglas and Peucker algorithm, removing all points,
+          that are closer than tolerance() to the simplified curve.
+          This is the default setting.
+         */
+        DouglasPeucker,
+
+        /*!
+          Visvalingam-Whyatt algorithm, removing the points 
+          of the least significant area one by one. A point
+          is removed as long as the area of the triangle with its 
+          neighbours is below 0.5 * tolerance() * tolerance() - 
+          what corresponds to a triangle with a base and a 
+          height of tolerance().
+         */
+        VisvalingamWhyatt
+    };
+
     QwtWeedingCurveFitter( double tolerance = 1.0 );
     virtual ~QwtWeedingCurveFitter();
 
+    void setAlgorithm( Algorithm );
+    Algorithm algorithm() const;
+
     void setTolerance( double );
     double tolerance() const;
 
     void setChunkSize( uint );
     uint chunkSize() const;
 
+    void setThreadCount( uint numThreads );
+    uint threadCount() const;
+
     virtual QPolygonF fitCurve( const QPolygonF & ) const;
     virtual QPainterPath fitCurvePath( const QPolygonF & ) const;
 
 private:
+    QPolygonF simplifyChunks( const QPointF *, int numPoints, 
+        int fromChunk, int toChunk ) const;
+
     virtual QPolygonF simplify( const QPolygonF & ) const;
+    virtual QPolygonF simplify( const QPointF *, int numPoints ) const;
+
+    QPolygonF simplifyDouglasPeucker( const QPointF *, int numPoints ) const;
+    QPolygonF simplifyVisvalingamWhyatt( const QPointF *, int numPoints ) const;
 
     class Line;
 
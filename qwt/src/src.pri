@@ -105,11 +105,14 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.h \
         qwt_legend_data.h \
         qwt_legend_label.h \
+        qwt_virtual_legend.h \
         qwt_plot.h \
         qwt_plot_renderer.h \
+        qwt_plot_image_renderer.h \
         qwt_plot_curve.h \
         qwt_plot_dict.h \
         qwt_plot_directpainter.h \
+        qwt_plot_frame_record.h \
         qwt_plot_grid.h \
         qwt_plot_histogram.h \
         qwt_plot_item.h \
@@ -153,8 +156,10 @@ contains(QWT_CONFIG, QwtPlot) {
         qwt_legend.cpp \
         qwt_legend_data.cpp \
         qwt_legend_label.cpp \
+        qwt_virtual_legend.cpp \
         qwt_plot.cpp \
         qwt_plot_renderer.cpp \
+        qwt_plot_image_renderer.cpp \
         qwt_plot_xml.cpp \
         qwt_plot_axis.cpp \
         qwt_plot_curve.cpp \
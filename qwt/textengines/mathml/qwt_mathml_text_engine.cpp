@@ -11,17 +11,97 @@
 
 #include <qstring.h>
 #include <qpainter.h>
+#include <qcache.h>
+#include <qmutex.h>
 #include "qwt_mathml_text_engine.h"
 #include "qwt_mml_document.h"
 
+static inline QString qwtCacheKey( const QString &text, qreal pointSize )
+{
+    return QString::number( pointSize ) + QLatin1Char( '|' ) + text;
+}
+
+class QwtMathMLTextEngine::PrivateData
+{
+public:
+    PrivateData():
+        cache( 100 )
+    {
+    }
+
+    /*
+      Painting a document modifies its nodes, so a document
+      is removed from the cache while it is in use.
+     */
+    QwtMathMLDocument *takeDocument( const QString &text, qreal pointSize )
+    {
+        const QString key = qwtCacheKey( text, pointSize );
+
+        mutex.lock();
+        QwtMathMLDocument *doc = cache.take( key );
+        mutex.unlock();
+
+        if ( doc == NULL )
+        {
+            doc = new QwtMathMLDocument();
+            doc->setContent( text );
+            doc->setBaseFontPointSize( pointSize );
+        }
+
+        return doc;
+    }
+
+    void releaseDocument( const QString &text,
+        qreal pointSize, QwtMathMLDocument *doc )
+    {
+        const QString key = qwtCacheKey( text, pointSize );
+
+        QMutexLocker locker( &mutex );
+        cache.insert( key, doc );
+    }
+
+    QMutex mutex;
+
+    // LRU cache of parsed and layouted documents
+    QCache<QString, QwtMathMLDocument> cache;
+};
+
 //! Constructor
 QwtMathMLTextEngine::QwtMathMLTextEngine()
 {
+    d_data = new PrivateData;
 }
 
 //! Destructor
 QwtMathMLTextEngine::~QwtMathMLTextEngine()
 {
+    delete d_data;
+}
+
+/*!
+  Set the maximum number of documents in the cache
+
+  When the cache is full the least recently used document is discarded.
+  The default setting is 100.
+
+  \param numDocuments Maximum number of cached documents,
+                      0 disables caching
+  \sa cacheSize()
+*/
+void QwtMathMLTextEngine::setCacheSize( int numDocuments )
+{
+    QMutexLocker locker( &d_data->mutex );
+    d_data->cache.setMaxCost( qMax( numDocuments, 0 ) );
+}
+
+/*!
+  \return Maximum number of documents in the cache
+  \sa setCacheSize()
+*/
+int QwtMathMLTextEngine::cacheSize() const
+{
+    QMutexLocker locker( &d_data->mutex );
+    return d_data->cache.maxCost();
 }
 
 /*!
@@ -54,20 +134,13 @@ QSizeF QwtMathMLTextEngine::textSize( const QFont &font,
 {
     Q_UNUSED( flags );
 
-    static QString t;
-    static QSizeF sz;
+    const qreal pointSize = font.pointSizeF();
 
-    if ( text != t )
-    {
-        QwtMathMLDocument doc;
-        doc.setContent( text );
-        doc.setBaseFontPointSize( font.pointSizeF() );
+    QwtMathMLDocument *doc = d_data->takeDocument( text, pointSize );
+    const QSizeF size = doc->size();
+    d_data->releaseDocument( text, pointSize, doc );
 
-        sz = doc.size();
-        t = text;
-    }
-
-    return sz;
+    return size;
 }
 
 /*!
@@ -95,11 +168,11 @@ void QwtMathMLTextEngine::textMargins( const QFont &, const QString &,
 void QwtMathMLTextEngine::draw( QPainter *painter, const QRectF &rect,
     int flags, const QString& text ) const
 {
-    QwtMathMLDocument doc;
-    doc.setContent( text );
-    doc.setBaseFontPointSize( painter->font().pointSizeF() );
+    const qreal pointSize = painter->font().pointSizeF();
 
-    const QSizeF docSize = doc.size();
+    QwtMathMLDocument *doc = d_data->takeDocument( text, pointSize );
+
+    const QSizeF docSize = doc->size();
 
     QPointF pos = rect.topLeft();
     if ( rect.width() > docSize.width() )
@@ -117,7 +190,9 @@ void QwtMathMLTextEngine::draw( QPainter *painter, const QRectF &rect,
             pos.setY( rect.center().y() - docSize.height() / 2 );
     }
 
-    doc.paint( painter, pos.toPoint() );
+    doc->paint( painter, pos.toPoint() );
+
+    d_data->releaseDocument( text, pointSize, doc );
 }
 
 /*!
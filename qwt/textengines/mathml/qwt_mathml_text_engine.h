@@ -25,6 +25,11 @@
 QwtText::setTextEngine(QwtText::MathMLText, new QwtMathMLTextEngine());
   \endverbatim
 
+  Parsing and layouting a MathML expression is expensive, so the
+  documents are kept in a cache of limited size, that is shared between
+  textSize() and draw(). The cache is protected by a mutex, so that
+  the engine can be used from render threads.
+
   \sa QwtTextEngine, QwtText::setTextEngine
   \warning Unfortunately the MathML renderer doesn't support rotating of texts.
 */
@@ -48,6 +53,13 @@ public:
 
     virtual void textMargins( const QFont &, const QString &,
         double &left, double &right, double &top, double &bottom ) const;
+
+    void setCacheSize( int numDocuments );
+    int cacheSize() const;
+
+private:
+    class PrivateData;
+    PrivateData *d_data;
 };
 
 #endif